@@ -0,0 +1,176 @@
+#include "Benchmark.h"
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <ctime>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+#ifndef LAF_BENCH_BUILD_TYPE
+#define LAF_BENCH_BUILD_TYPE "unknown"
+#endif
+
+namespace LockedAndFlow::Bench {
+
+    namespace {
+
+        struct Registration {
+            std::string name;
+            BenchmarkFunction function;
+        };
+
+        struct Result {
+            std::string name;
+            std::uint64_t iterations;
+            double nsPerIteration;
+            double itemsPerSecond;
+        };
+
+        std::vector<Registration>& registry() {
+            static std::vector<Registration> benchmarks;
+            return benchmarks;
+        }
+
+        struct Options {
+            std::string filter;
+            std::string jsonPath;
+            double minTimeSeconds = 0.2;
+        };
+
+        Options parseOptions(int argc, char** argv) {
+            Options options;
+            for (int i = 1; i < argc; ++i) {
+                const std::string_view arg(argv[i]);
+                if (arg.rfind("--filter=", 0) == 0) {
+                    options.filter = std::string(arg.substr(9));
+                }
+                else if (arg.rfind("--json=", 0) == 0) {
+                    options.jsonPath = std::string(arg.substr(7));
+                }
+                else if (arg.rfind("--min-time=", 0) == 0) {
+                    options.minTimeSeconds = std::atof(std::string(arg.substr(11)).c_str());
+                }
+                else {
+                    std::fprintf(stderr,
+                        "Usage: %s [--filter=<substring>] [--min-time=<seconds>] [--json=<path>|-]\n", argv[0]);
+                    std::exit(arg == "--help" ? 0 : 1);
+                }
+            }
+            return options;
+        }
+
+        Result runOne(const Registration& benchmark, double minTimeSeconds) {
+            const auto minTime = std::chrono::duration<double>(minTimeSeconds);
+            std::uint64_t iterations = 1;
+
+            for (;;) {
+                State state(iterations);
+                benchmark.function(state);
+                const auto elapsed = state.getElapsed();
+
+                const auto seconds = std::chrono::duration<double>(elapsed).count();
+                if (elapsed >= minTime || iterations >= (std::uint64_t{ 1 } << 40)) {
+                    const double ns = static_cast<double>(elapsed.count()) / static_cast<double>(iterations);
+                    const double items = static_cast<double>(iterations * state.getItemsPerIteration());
+                    return Result{ benchmark.name, iterations, ns, seconds > 0.0 ? items / seconds : 0.0 };
+                }
+
+                // Aim 40% past the minimum so the next run very likely qualifies
+                const double scale = seconds > 0.0 ? (minTime.count() * 1.4) / seconds : 100.0;
+                const double next = static_cast<double>(iterations) * std::clamp(scale, 2.0, 100.0);
+                iterations = static_cast<std::uint64_t>(next);
+            }
+        }
+
+        void writeJson(std::FILE* out, const std::vector<Result>& results) {
+            char date[32] = "";
+            const std::time_t now = std::time(nullptr);
+            std::strftime(date, sizeof(date), "%Y-%m-%dT%H:%M:%SZ", std::gmtime(&now));
+
+            std::fprintf(out, "{\n  \"context\": {\n");
+            std::fprintf(out, "    \"date\": \"%s\",\n", date);
+            std::fprintf(out, "    \"library_build_type\": \"%s\"\n", LAF_BENCH_BUILD_TYPE);
+            std::fprintf(out, "  },\n  \"benchmarks\": [\n");
+            for (std::size_t i = 0; i < results.size(); ++i) {
+                const auto& result = results[i];
+                std::fprintf(out,
+                    "    {\"name\": \"%s\", \"iterations\": %llu, \"real_time\": %.3f, "
+                    "\"time_unit\": \"ns\", \"items_per_second\": %.1f}%s\n",
+                    result.name.c_str(),
+                    static_cast<unsigned long long>(result.iterations),
+                    result.nsPerIteration,
+                    result.itemsPerSecond,
+                    i + 1 < results.size() ? "," : "");
+            }
+            std::fprintf(out, "  ]\n}\n");
+        }
+
+    } // namespace
+
+    State::Iterator State::begin() {
+        startTime_ = std::chrono::steady_clock::now();
+        return Iterator(this, iterations_);
+    }
+
+    void State::finish() noexcept {
+        endTime_ = std::chrono::steady_clock::now();
+    }
+
+    bool registerBenchmark(std::string name, BenchmarkFunction function) {
+        registry().push_back(Registration{ std::move(name), std::move(function) });
+        return true;
+    }
+
+    int runBenchmarks(int argc, char** argv) {
+        const Options options = parseOptions(argc, argv);
+
+        auto benchmarks = registry();
+        std::sort(benchmarks.begin(), benchmarks.end(),
+            [](const Registration& a, const Registration& b) { return a.name < b.name; });
+
+        const bool jsonToStdout = options.jsonPath == "-";
+        std::vector<Result> results;
+
+        if (!jsonToStdout) {
+            std::printf("%-56s %14s %14s %16s\n", "Benchmark", "Time (ns)", "Iterations", "Items/s");
+            std::printf("%s\n", std::string(103, '-').c_str());
+        }
+
+        for (const auto& benchmark : benchmarks) {
+            if (!options.filter.empty() && benchmark.name.find(options.filter) == std::string::npos) {
+                continue;
+            }
+
+            results.push_back(runOne(benchmark, options.minTimeSeconds));
+            const auto& result = results.back();
+            if (!jsonToStdout) {
+                std::printf("%-56s %14.2f %14llu %16.0f\n",
+                    result.name.c_str(),
+                    result.nsPerIteration,
+                    static_cast<unsigned long long>(result.iterations),
+                    result.itemsPerSecond);
+            }
+        }
+
+        if (jsonToStdout) {
+            writeJson(stdout, results);
+        }
+        else if (!options.jsonPath.empty()) {
+            std::FILE* out = std::fopen(options.jsonPath.c_str(), "w");
+            if (!out) {
+                std::fprintf(stderr, "Failed to open %s for writing\n", options.jsonPath.c_str());
+                return 1;
+            }
+            writeJson(out, results);
+            std::fclose(out);
+        }
+
+        return 0;
+    }
+
+} // namespace LockedAndFlow::Bench
+
+int main(int argc, char** argv) {
+    return LockedAndFlow::Bench::runBenchmarks(argc, argv);
+}
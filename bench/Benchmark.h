@@ -0,0 +1,97 @@
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <string>
+
+namespace LockedAndFlow::Bench {
+
+    /**
+     * @brief Per-run state handed to every benchmark body
+     *
+     * Mirrors the Google Benchmark idiom: the body does its setup, then loops
+     * with `for (auto _ : state)` around the code being measured. The harness
+     * picks the iteration count so that each run lasts at least the configured
+     * minimum time.
+     */
+    class State {
+    public:
+        explicit State(std::uint64_t iterations) noexcept
+            : iterations_(iterations) {
+        }
+
+        // What `for (auto _ : state)` binds: marked maybe_unused so the idiom's
+        // never-read loop variable does not trip -Wunused-variable
+        struct [[maybe_unused]] Value {};
+
+        class Iterator {
+        public:
+            Iterator(State* state, std::uint64_t remaining) noexcept
+                : state_(state), remaining_(remaining) {
+            }
+
+            bool operator!=(const Iterator&) noexcept {
+                if (remaining_ != 0) {
+                    return true;
+                }
+                state_->finish();
+                return false;
+            }
+            void operator++() noexcept { --remaining_; }
+            Value operator*() const noexcept { return {}; }
+
+        private:
+            State* state_;
+            std::uint64_t remaining_;
+        };
+
+        Iterator begin();
+        Iterator end() noexcept { return Iterator(this, 0); }
+
+        std::uint64_t getIterations() const noexcept { return iterations_; }
+
+        // Items processed per iteration, for benchmarks that handle a batch per loop
+        void setItemsPerIteration(std::uint64_t items) noexcept { itemsPerIteration_ = items; }
+        std::uint64_t getItemsPerIteration() const noexcept { return itemsPerIteration_; }
+
+        // Time spent inside the measured loop
+        std::chrono::nanoseconds getElapsed() const noexcept { return endTime_ - startTime_; }
+
+    private:
+        std::uint64_t iterations_;
+        std::uint64_t itemsPerIteration_ = 1;
+        std::chrono::steady_clock::time_point startTime_;
+        std::chrono::steady_clock::time_point endTime_;
+
+        void finish() noexcept;
+    };
+
+    using BenchmarkFunction = std::function<void(State&)>;
+
+    // Registers a benchmark under a slash-separated name (e.g. "Timer/getElapsed/Running")
+    bool registerBenchmark(std::string name, BenchmarkFunction function);
+
+    // Runs every registered benchmark matching the command line filter
+    int runBenchmarks(int argc, char** argv);
+
+    // Keeps the compiler from discarding a computed value
+    template <typename T>
+    inline void doNotOptimize(const T& value) {
+#if defined(__GNUC__) || defined(__clang__)
+        asm volatile("" : : "g"(&value) : "memory");
+#else
+        static volatile const void* sink;
+        sink = &value;
+#endif
+    }
+
+} // namespace LockedAndFlow::Bench
+
+#define LAF_BENCH_CONCAT_IMPL(a, b) a##b
+#define LAF_BENCH_CONCAT(a, b) LAF_BENCH_CONCAT_IMPL(a, b)
+
+// Registers a free function `void fn(State&)` under its own name
+#define LAF_BENCHMARK(fn) \
+    static const bool LAF_BENCH_CONCAT(fn##_registered_, __LINE__) = \
+        ::LockedAndFlow::Bench::registerBenchmark(#fn, fn)
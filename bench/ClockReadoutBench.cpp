@@ -0,0 +1,119 @@
+#include "Benchmark.h"
+#include "ClockReadout.h"
+#include "DefaultFont.h"
+#include "DurationFormat.h"
+#include <cstdio>
+#include <cstdlib>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace LockedAndFlow::Bench {
+
+    namespace {
+
+        constexpr std::size_t kReadouts = 1000;
+        constexpr unsigned int kCharacterSize = 24;
+
+        // The embedded default font, or the one named by LAF_BENCH_FONT
+        const sf::Font& benchFont() {
+            static sf::Font override;
+            static const bool overridden = [] {
+                const char* path = std::getenv("LAF_BENCH_FONT");
+                return path && override.openFromFile(path);
+            }();
+            return overridden ? override : getDefaultFont();
+        }
+
+        // Offscreen target; also provides the OpenGL context the atlas bakes in
+        sf::RenderTexture& benchTarget() {
+            static sf::RenderTexture target;
+            static bool created = false;
+            if (!created) {
+                if (!target.resize({ 1280, 720 })) {
+                    std::fprintf(stderr, "ClockReadout benchmarks need an OpenGL context\n");
+                    std::abort();
+                }
+                created = true;
+            }
+            return target;
+        }
+
+        sf::Vector2f gridPosition(std::size_t index) {
+            return { static_cast<float>(index % 10) * 120.0f, static_cast<float>(index / 10) * 7.0f };
+        }
+
+        // Each readout shows a different time and every one changes each iteration
+        Timer::Duration readoutTime(std::uint64_t iteration, std::size_t index) {
+            return std::chrono::seconds(iteration) + std::chrono::seconds(index * 7);
+        }
+
+        // The old TimerDisplay path: setString() plus the geometry rebuild that the
+        // next draw (or bounds query) triggers
+        void runTextPath(State& state, bool draw) {
+            sf::RenderTexture& target = benchTarget();
+            std::vector<sf::Text> texts;
+            texts.reserve(kReadouts);
+            for (std::size_t i = 0; i < kReadouts; ++i) {
+                texts.emplace_back(benchFont(), "00:00:00", kCharacterSize);
+                texts.back().setPosition(gridPosition(i));
+            }
+
+            std::uint64_t iteration = 0;
+            state.setItemsPerIteration(kReadouts);
+            for (auto _ : state) {
+                ++iteration;
+                for (std::size_t i = 0; i < kReadouts; ++i) {
+                    texts[i].setString(formatDuration(readoutTime(iteration, i)).c_str());
+                    if (draw) {
+                        target.draw(texts[i]);
+                    }
+                    else {
+                        doNotOptimize(texts[i].getLocalBounds());
+                    }
+                }
+                if (draw) {
+                    target.display();
+                }
+            }
+        }
+
+        void runAtlasPath(State& state, bool draw) {
+            sf::RenderTexture& target = benchTarget();
+            const ClockGlyphAtlas& atlas = ClockGlyphAtlas::get(benchFont(), kCharacterSize);
+            std::vector<ClockReadout> readouts(kReadouts, ClockReadout(atlas));
+            for (std::size_t i = 0; i < kReadouts; ++i) {
+                readouts[i].setText("00:00:00");
+                readouts[i].setPosition(gridPosition(i));
+            }
+
+            std::uint64_t iteration = 0;
+            state.setItemsPerIteration(kReadouts);
+            for (auto _ : state) {
+                ++iteration;
+                for (std::size_t i = 0; i < kReadouts; ++i) {
+                    doNotOptimize(readouts[i].setText(formatDuration(readoutTime(iteration, i)).view()));
+                    if (draw) {
+                        target.draw(readouts[i]);
+                    }
+                }
+                if (draw) {
+                    target.display();
+                }
+            }
+        }
+
+        bool registerClockReadoutBenchmarks() {
+            const auto suffix = "/" + std::to_string(kReadouts);
+            registerBenchmark("ClockReadout/update/sfText" + suffix, [](State& state) { runTextPath(state, false); });
+            registerBenchmark("ClockReadout/update/glyphAtlas" + suffix, [](State& state) { runAtlasPath(state, false); });
+            registerBenchmark("ClockReadout/updateAndDraw/sfText" + suffix, [](State& state) { runTextPath(state, true); });
+            registerBenchmark("ClockReadout/updateAndDraw/glyphAtlas" + suffix, [](State& state) { runAtlasPath(state, true); });
+            return true;
+        }
+
+        const bool clockReadoutBenchmarksRegistered = registerClockReadoutBenchmarks();
+
+    } // namespace
+
+} // namespace LockedAndFlow::Bench
@@ -0,0 +1,147 @@
+#include "Benchmark.h"
+#include "ControlProtocol.h"
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+#include <vector>
+#ifdef __linux__
+#include <sys/socket.h>
+#include <unistd.h>
+#endif
+
+namespace LockedAndFlow::Bench {
+
+    namespace {
+
+        constexpr std::size_t kLinesPerBatch = 1024;
+        constexpr std::size_t kTimerCounts[] = { 16, 4096 };
+
+        // A script's worth of pipelined requests spread over @p timerCount names
+        std::string makeBatch(std::size_t timerCount) {
+            static const char* const kVerbs[] = { "start", "query", "pause", "query", "target", "stop", "query", "reset" };
+
+            std::string batch;
+            for (std::size_t i = 0; i < kLinesPerBatch; ++i) {
+                const char* verb = kVerbs[i % std::size(kVerbs)];
+                batch += verb;
+                batch += " job-";
+                batch += std::to_string((i * 7919) % timerCount);
+                if (std::string(verb) == "target") {
+                    batch += " 1500000";
+                }
+                batch += '\n';
+            }
+            return batch;
+        }
+
+        // Creates every timer the batch names, so queries in it always find one
+        void createTimers(ControlProtocol& protocol, std::size_t timerCount) {
+            std::string setup;
+            for (std::size_t i = 0; i < timerCount; ++i) {
+                setup += "reset job-" + std::to_string(i) + "\n";
+            }
+            std::string replies;
+            protocol.process(setup, Timer::ClockType::now(), replies);
+        }
+
+        void checkReplies(const std::string& replies, const char* benchmark) {
+            const auto lines = static_cast<std::size_t>(std::count(replies.begin(), replies.end(), '\n'));
+            if (lines != kLinesPerBatch || replies.find("err") != std::string::npos) {
+                std::fprintf(stderr, "%s: expected %zu ok replies, got %zu lines\n", benchmark, kLinesPerBatch, lines);
+                std::abort();
+            }
+        }
+
+        // Parse + execute + format only: the daemon's per-request cost without syscalls
+        void runProcessBatch(State& state, std::size_t timerCount) {
+            TimerPool pool;
+            ControlProtocol protocol(pool);
+            createTimers(protocol, timerCount);
+            const std::string batch = makeBatch(timerCount);
+            std::string replies;
+
+            state.setItemsPerIteration(kLinesPerBatch);
+            for (auto _ : state) {
+                replies.clear();
+                doNotOptimize(protocol.process(batch, Timer::ClockType::now(), replies));
+            }
+            checkReplies(replies, "ControlProtocol/process");
+        }
+
+#ifdef __linux__
+        // The daemon's transport: one pipelined write, one read + process, one reply
+        // write and one read back, over a connected Unix socket pair
+        void runSocketRoundTrip(State& state, std::size_t timerCount) {
+            int sockets[2];
+            if (::socketpair(AF_UNIX, SOCK_STREAM, 0, sockets) != 0) {
+                std::perror("socketpair");
+                std::abort();
+            }
+
+            TimerPool pool;
+            ControlProtocol protocol(pool);
+            createTimers(protocol, timerCount);
+            const std::string batch = makeBatch(timerCount);
+            std::string input;
+            std::string replies;
+            std::string received;
+            std::vector<char> buffer(256 * 1024);
+
+            // Reads until @p expectedLines complete lines have arrived
+            const auto readAll = [&](int fd, std::string& out, std::size_t expectedLines) {
+                std::size_t lines = 0;
+                while (lines < expectedLines) {
+                    const ssize_t count = ::read(fd, buffer.data(), buffer.size());
+                    if (count <= 0) {
+                        std::perror("read");
+                        std::abort();
+                    }
+                    out.append(buffer.data(), static_cast<std::size_t>(count));
+                    lines += static_cast<std::size_t>(std::count(buffer.data(), buffer.data() + count, '\n'));
+                }
+            };
+
+            state.setItemsPerIteration(kLinesPerBatch);
+            for (auto _ : state) {
+                if (::write(sockets[0], batch.data(), batch.size()) != static_cast<ssize_t>(batch.size())) {
+                    std::abort();
+                }
+
+                input.clear();
+                replies.clear();
+                readAll(sockets[1], input, kLinesPerBatch);
+                protocol.process(input, Timer::ClockType::now(), replies);
+                if (::write(sockets[1], replies.data(), replies.size()) != static_cast<ssize_t>(replies.size())) {
+                    std::abort();
+                }
+
+                received.clear();
+                readAll(sockets[0], received, kLinesPerBatch);
+                doNotOptimize(received.size());
+            }
+            checkReplies(replies, "ControlProtocol/socketRoundTrip");
+
+            ::close(sockets[0]);
+            ::close(sockets[1]);
+        }
+#endif
+
+        bool registerControlProtocolBenchmarks() {
+            for (const auto timerCount : kTimerCounts) {
+                const auto suffix = "/" + std::to_string(timerCount);
+                registerBenchmark("ControlProtocol/process" + suffix,
+                    [=](State& state) { runProcessBatch(state, timerCount); });
+#ifdef __linux__
+                registerBenchmark("ControlProtocol/socketRoundTrip" + suffix,
+                    [=](State& state) { runSocketRoundTrip(state, timerCount); });
+#endif
+            }
+            return true;
+        }
+
+        const bool controlProtocolBenchmarksRegistered = registerControlProtocolBenchmarks();
+
+    } // namespace
+
+} // namespace LockedAndFlow::Bench
@@ -0,0 +1,79 @@
+#include "Benchmark.h"
+#include "DurationFormat.h"
+#include <iomanip>
+#include <random>
+#include <sstream>
+#include <string>
+#include <vector>
+
+namespace LockedAndFlow::Bench {
+
+    namespace {
+
+        constexpr std::size_t kDurations = 4096;
+
+        // The TimerDisplay::formatDuration this kernel replaced
+        std::string legacyFormatDuration(Timer::Duration duration) {
+            const auto totalSeconds = duration.count() / 1000;
+            const auto hours = totalSeconds / 3600;
+            const auto minutes = (totalSeconds % 3600) / 60;
+            const auto seconds = totalSeconds % 60;
+
+            std::ostringstream oss;
+            oss << std::setfill('0') << std::setw(2) << hours << ":"
+                << std::setfill('0') << std::setw(2) << minutes << ":"
+                << std::setfill('0') << std::setw(2) << seconds;
+
+            return oss.str();
+        }
+
+        // Up to ~200 hours so both the two-digit and widened hour fields are exercised
+        std::vector<Timer::Duration> makeDurations() {
+            std::mt19937_64 random(42);
+            std::vector<Timer::Duration> durations(kDurations);
+            for (auto& duration : durations) {
+                duration = Timer::Duration(static_cast<std::int64_t>(random() % (200LL * 3600 * 1000)));
+            }
+            return durations;
+        }
+
+        void runLegacy(State& state) {
+            const auto durations = makeDurations();
+            std::size_t index = 0;
+            for (auto _ : state) {
+                auto text = legacyFormatDuration(durations[index++ % kDurations]);
+                doNotOptimize(text);
+            }
+        }
+
+        void runKernel(State& state, DurationStyle style, unsigned fractionalDigits) {
+            const auto durations = makeDurations();
+            char buffer[kMaxFormattedDurationLength];
+            std::size_t index = 0;
+            for (auto _ : state) {
+                auto length = formatDuration(buffer, sizeof(buffer), durations[index++ % kDurations],
+                    style, fractionalDigits);
+                doNotOptimize(length);
+                doNotOptimize(buffer);
+            }
+        }
+
+        bool registerDurationFormatBenchmarks() {
+            registerBenchmark("DurationFormat/ostringstream", runLegacy);
+            registerBenchmark("DurationFormat/HHMMSS", [](State& state) {
+                runKernel(state, DurationStyle::HoursMinutesSeconds, 0);
+            });
+            registerBenchmark("DurationFormat/MMSS", [](State& state) {
+                runKernel(state, DurationStyle::MinutesSeconds, 0);
+            });
+            registerBenchmark("DurationFormat/HHMMSS.mmm", [](State& state) {
+                runKernel(state, DurationStyle::HoursMinutesSeconds, 3);
+            });
+            return true;
+        }
+
+        const bool durationFormatBenchmarksRegistered = registerDurationFormatBenchmarks();
+
+    } // namespace
+
+} // namespace LockedAndFlow::Bench
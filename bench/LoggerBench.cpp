@@ -0,0 +1,70 @@
+#include "Benchmark.h"
+#include "DurationFormat.h"
+#include "Logger.h"
+#include <filesystem>
+#include <fstream>
+#include <string>
+
+namespace LockedAndFlow::Bench {
+
+    namespace {
+
+        constexpr std::size_t kMessagesPerBatch = Logger::kCapacity / 2;
+
+        std::string logPath(const char* name) {
+            return (std::filesystem::temp_directory_path() / name).string();
+        }
+
+        // What main.cpp did per event: format inline and flush the stream every line
+        void runEndlToFile(State& state) {
+            const auto path = logPath("lockedandflow_bench_endl.log");
+            {
+                std::ofstream out(path, std::ios::trunc);
+                Timer::Duration elapsed(0);
+                for (auto _ : state) {
+                    elapsed += std::chrono::seconds(1);
+                    out << "Timer running: " << formatDuration(elapsed).view() << std::endl;
+                }
+            }
+            std::filesystem::remove(path);
+        }
+
+        // The async logger end to end: half a ring of messages, then a flush that
+        // waits for the writer thread to format and write all of them
+        void runAsyncToFile(State& state) {
+            const auto path = logPath("lockedandflow_bench_async.log");
+            {
+                std::ofstream out(path, std::ios::trunc);
+                Logger logger(out);
+                Timer::Duration elapsed(0);
+
+                state.setItemsPerIteration(kMessagesPerBatch);
+                for (auto _ : state) {
+                    for (std::size_t i = 0; i < kMessagesPerBatch; ++i) {
+                        elapsed += std::chrono::seconds(1);
+                        logger.log(LogLevel::Info, "Timer running: {}", elapsed);
+                    }
+                    logger.flush();
+                }
+                doNotOptimize(logger.getDroppedCount());
+            }
+            std::filesystem::remove(path);
+        }
+
+        // A call below the compiled-in level: no code at all
+        void runCompiledOut(State& state) {
+            Timer::Duration elapsed(0);
+            for (auto _ : state) {
+                elapsed += std::chrono::seconds(1);
+                LAF_LOG_TRACE("Timer running: {}", elapsed);
+                doNotOptimize(elapsed);
+            }
+        }
+
+        const bool endlRegistered = registerBenchmark("Logger/endlToFile", runEndlToFile);
+        const bool asyncRegistered = registerBenchmark("Logger/asyncToFile", runAsyncToFile);
+        const bool compiledOutRegistered = registerBenchmark("Logger/compiledOut", runCompiledOut);
+
+    } // namespace
+
+} // namespace LockedAndFlow::Bench
@@ -0,0 +1,87 @@
+#include "Benchmark.h"
+#include "RollupTable.h"
+#include <filesystem>
+#include <random>
+#include <string>
+
+namespace LockedAndFlow::Bench {
+
+    namespace {
+
+        constexpr std::size_t kSessions = 100000;
+        const WallTime kHistoryStart{ std::chrono::hours(24 * 365 * 50) };
+
+        std::string storePath() {
+            return (std::filesystem::temp_directory_path() / "lockedandflow_bench_rollup.sessions").string();
+        }
+
+        void removeStore(const std::string& path) {
+            std::filesystem::remove(path);
+            std::filesystem::remove(path + ".idx");
+        }
+
+        // A few years of sessions, ending at the returned time
+        WallTime fillStore(SessionStore& store) {
+            std::mt19937_64 random(42);
+            WallTime time = kHistoryStart;
+            for (std::size_t i = 0; i < kSessions; ++i) {
+                time += std::chrono::minutes(1 + random() % 120);
+                const auto end = time + std::chrono::minutes(5 + random() % 55);
+                store.append(time, end);
+                time = end;
+            }
+            return time;
+        }
+
+        // "Total focus per day for the last year": one lookup per day
+        void runYearOfDays(State& state, bool useRollups) {
+            const auto path = storePath();
+            removeStore(path);
+
+            SessionStore store;
+            if (!store.open(path)) {
+                return;
+            }
+            const WallTime last = fillStore(store);
+
+            RollupTable rollups(std::chrono::minutes(0));
+            rollups.catchUp(store);
+
+            const WallTime yearStart = last - std::chrono::hours(24 * 365);
+            state.setItemsPerIteration(365);
+            for (auto _ : state) {
+                Timer::Duration sum = Timer::Duration::zero();
+                for (int day = 0; day < 365; ++day) {
+                    const WallTime from = yearStart + std::chrono::hours(24 * day);
+                    sum += useRollups ? rollups.getDayTotal(from)
+                                      : store.getFocusTime(from, from + std::chrono::hours(24));
+                }
+                doNotOptimize(sum);
+            }
+
+            store.close();
+            removeStore(path);
+        }
+
+        void runAddSession(State& state) {
+            RollupTable rollups(std::chrono::minutes(0));
+            WallTime time = kHistoryStart;
+            for (auto _ : state) {
+                rollups.addSession(time, time + std::chrono::minutes(25));
+                time += std::chrono::minutes(40);
+            }
+            doNotOptimize(rollups.getMonthTotal(time));
+        }
+
+        bool registerRollupTableBenchmarks() {
+            registerBenchmark("RollupTable/yearOfDays/Rollups", [](State& state) { runYearOfDays(state, true); });
+            registerBenchmark("RollupTable/yearOfDays/SessionScan", [](State& state) { runYearOfDays(state, false); });
+            registerBenchmark("RollupTable/addSession", runAddSession);
+            return true;
+        }
+
+        const bool rollupTableBenchmarksRegistered = registerRollupTableBenchmarks();
+
+    } // namespace
+
+} // namespace LockedAndFlow::Bench
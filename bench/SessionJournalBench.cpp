@@ -0,0 +1,78 @@
+#include "Benchmark.h"
+#include "SessionJournal.h"
+#include <filesystem>
+#include <string>
+
+namespace LockedAndFlow::Bench {
+
+    namespace {
+
+        std::string journalPath(const char* name) {
+            return (std::filesystem::temp_directory_path() / name).string();
+        }
+
+        void runAppend(State& state, JournalSyncPolicy policy) {
+            const auto path = journalPath("lockedandflow_bench.journal");
+            std::filesystem::remove(path);
+
+            SessionJournal journal;
+            if (!journal.open(path, policy)) {
+                return;
+            }
+
+            Timer timer;
+            timer.setTargetDuration(std::chrono::minutes(25));
+            const auto at = wallNow();
+
+            for (auto _ : state) {
+                journal.append(JournalEvent::Start, timer, at);
+            }
+
+            journal.close();
+            std::filesystem::remove(path);
+        }
+
+        // Replays a million-record journal (about a month of heavy use)
+        void runReplay(State& state) {
+            constexpr std::size_t kRecords = 1000000;
+            const auto path = journalPath("lockedandflow_bench_replay.journal");
+            std::filesystem::remove(path);
+
+            {
+                SessionJournal journal;
+                if (!journal.open(path, JournalSyncPolicy::everyNEvents(kRecords))) {
+                    return;
+                }
+                Timer timer;
+                const auto at = wallNow();
+                for (std::size_t i = 0; i < kRecords; ++i) {
+                    journal.append(i % 2 ? JournalEvent::Pause : JournalEvent::Start, timer, at);
+                }
+            }
+
+            state.setItemsPerIteration(kRecords);
+            for (auto _ : state) {
+                std::size_t count = 0;
+                SessionJournal::replay(path, [&count](const JournalRecord&) { ++count; });
+                doNotOptimize(count);
+            }
+
+            std::filesystem::remove(path);
+        }
+
+        bool registerSessionJournalBenchmarks() {
+            registerBenchmark("SessionJournal/append/EveryEvent",
+                [](State& state) { runAppend(state, JournalSyncPolicy::everyEvent()); });
+            registerBenchmark("SessionJournal/append/Every256",
+                [](State& state) { runAppend(state, JournalSyncPolicy::everyNEvents(256)); });
+            registerBenchmark("SessionJournal/append/Interval1s",
+                [](State& state) { runAppend(state, JournalSyncPolicy::everyInterval(std::chrono::seconds(1))); });
+            registerBenchmark("SessionJournal/replay/1M", runReplay);
+            return true;
+        }
+
+        const bool sessionJournalBenchmarksRegistered = registerSessionJournalBenchmarks();
+
+    } // namespace
+
+} // namespace LockedAndFlow::Bench
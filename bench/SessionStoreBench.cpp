@@ -0,0 +1,88 @@
+#include "Benchmark.h"
+#include "SessionStore.h"
+#include <filesystem>
+#include <random>
+#include <string>
+
+namespace LockedAndFlow::Bench {
+
+    namespace {
+
+        constexpr std::size_t kSessions = 1000000;
+
+        std::string storePath() {
+            return (std::filesystem::temp_directory_path() / "lockedandflow_bench.sessions").string();
+        }
+
+        void removeStore(const std::string& path) {
+            std::filesystem::remove(path);
+            std::filesystem::remove(path + ".idx");
+        }
+
+        // Roughly a decade of sessions: 5-60 minute runs separated by short breaks
+        WallTime fillStore(SessionStore& store) {
+            std::mt19937_64 random(42);
+            WallTime time{ std::chrono::hours(24 * 365 * 50) };
+            for (std::size_t i = 0; i < kSessions; ++i) {
+                time += std::chrono::minutes(1 + random() % 240);
+                const auto end = time + std::chrono::minutes(5 + random() % 55);
+                store.append(time, end);
+                time = end;
+            }
+            return time;
+        }
+
+        // "How much focus time this week" at random points in the history
+        void runWeekQuery(State& state) {
+            const auto path = storePath();
+            removeStore(path);
+
+            SessionStore store;
+            if (!store.open(path)) {
+                return;
+            }
+            const WallTime first{ std::chrono::hours(24 * 365 * 50) };
+            const WallTime last = fillStore(store);
+            const auto span = (last - first).count();
+
+            std::mt19937_64 random(7);
+            for (auto _ : state) {
+                const WallTime from = first + Timer::Duration(static_cast<std::int64_t>(random() % span));
+                doNotOptimize(store.getFocusTime(from, from + std::chrono::hours(24 * 7)));
+            }
+
+            store.close();
+            removeStore(path);
+        }
+
+        // Reopening validates the sparse index instead of loading sessions
+        void runOpen(State& state) {
+            const auto path = storePath();
+            removeStore(path);
+            {
+                SessionStore store;
+                if (!store.open(path)) {
+                    return;
+                }
+                fillStore(store);
+            }
+
+            for (auto _ : state) {
+                SessionStore store;
+                doNotOptimize(store.open(path));
+            }
+
+            removeStore(path);
+        }
+
+        bool registerSessionStoreBenchmarks() {
+            registerBenchmark("SessionStore/getFocusTime/Week/1M", runWeekQuery);
+            registerBenchmark("SessionStore/open/1M", runOpen);
+            return true;
+        }
+
+        const bool sessionStoreBenchmarksRegistered = registerSessionStoreBenchmarks();
+
+    } // namespace
+
+} // namespace LockedAndFlow::Bench
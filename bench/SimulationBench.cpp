@@ -0,0 +1,48 @@
+#include "Benchmark.h"
+#include "TimerSimulation.h"
+#include <string>
+
+namespace LockedAndFlow::Bench {
+
+    namespace {
+
+        constexpr std::size_t kUserCounts[] = { 1000, 10000 };
+
+        // One simulated day per iteration; items are scheduler events (user actions,
+        // expiries and pool wakeups), so items/s is simulated events per second
+        void runSimulatedDays(State& state, SimulationConfig config) {
+            TimerSimulation simulation(config);
+            for (auto _ : state) {
+                simulation.runFor(std::chrono::hours(24));
+            }
+            state.setItemsPerIteration(simulation.getStats().events / state.getIterations());
+        }
+
+        bool registerSimulationBenchmarks() {
+            for (const std::size_t users : kUserCounts) {
+                const auto suffix = "/" + std::to_string(users);
+
+                SimulationConfig timers;
+                timers.users = users;
+                timers.drivePool = false;
+                timers.verify = false;
+                registerBenchmark("Simulation/Timer" + suffix, [timers](State& state) { runSimulatedDays(state, timers); });
+
+                SimulationConfig pool = timers;
+                pool.driveTimers = false;
+                pool.drivePool = true;
+                registerBenchmark("Simulation/TimerPool" + suffix, [pool](State& state) { runSimulatedDays(state, pool); });
+
+                // Both implementations, cross-checked against the model and each other
+                SimulationConfig verified;
+                verified.users = users;
+                registerBenchmark("Simulation/verified" + suffix, [verified](State& state) { runSimulatedDays(state, verified); });
+            }
+            return true;
+        }
+
+        const bool simulationBenchmarksRegistered = registerSimulationBenchmarks();
+
+    } // namespace
+
+} // namespace LockedAndFlow::Bench
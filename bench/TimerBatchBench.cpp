@@ -0,0 +1,87 @@
+#include "Benchmark.h"
+#include "TimerBatch.h"
+#include "TimerPool.h"
+#include <string>
+#include <vector>
+
+namespace LockedAndFlow::Bench {
+
+    namespace {
+
+        constexpr std::size_t kTimerCount = 10000;
+
+        // A dashboard-like mix: most timers running, some paused or stopped, most with targets
+        void fillPool(TimerPool& pool, TimerPool::TimePoint now) {
+            pool.reserve(kTimerCount);
+            for (std::size_t i = 0; i < kTimerCount; ++i) {
+                const auto handle = pool.create();
+                if (i % 5 != 0) {
+                    pool.setTargetDuration(handle, std::chrono::minutes(25 + static_cast<int>(i % 30)));
+                }
+
+                pool.start(handle, now - std::chrono::seconds(static_cast<int>(i % 1500)));
+                if (i % 7 == 0) {
+                    pool.pause(handle, now);
+                }
+                else if (i % 11 == 0) {
+                    pool.stop(handle, now);
+                }
+            }
+        }
+
+        void runBatch(State& state, TimerBatchPath path) {
+            TimerPool pool;
+            fillPool(pool, std::chrono::steady_clock::now());
+
+            std::vector<Timer::Duration> elapsed(kTimerCount);
+            std::vector<Timer::Duration> remaining(kTimerCount);
+            std::vector<float> progress(kTimerCount);
+            const TimerBatchOutput output{ elapsed.data(), remaining.data(), progress.data() };
+
+            state.setItemsPerIteration(kTimerCount);
+            for (auto _ : state) {
+                evaluateTimerBatch(pool.getBatchInput(), std::chrono::steady_clock::now(), output, path);
+                doNotOptimize(progress.data());
+            }
+        }
+
+        // Baseline: the per-handle pool queries a dashboard would otherwise call
+        void runPerHandle(State& state) {
+            TimerPool pool;
+            fillPool(pool, std::chrono::steady_clock::now());
+
+            std::vector<TimerPool::Handle> handles;
+            for (std::uint32_t i = 0; i < kTimerCount; ++i) {
+                handles.push_back(TimerPool::Handle{ i, 0 });
+            }
+
+            state.setItemsPerIteration(kTimerCount);
+            for (auto _ : state) {
+                const auto now = std::chrono::steady_clock::now();
+                for (const auto handle : handles) {
+                    doNotOptimize(pool.getElapsed(handle, now));
+                    doNotOptimize(pool.getRemainingTime(handle, now));
+                    doNotOptimize(pool.getProgressPercent(handle, now));
+                }
+            }
+        }
+
+        bool registerTimerBatchBenchmarks() {
+            const auto suffix = "/" + std::to_string(kTimerCount);
+            for (const auto path : { TimerBatchPath::Scalar, TimerBatchPath::Sse2, TimerBatchPath::Avx2 }) {
+                // Skip the AVX2 kernel where it would silently degrade
+                if (path == TimerBatchPath::Avx2 && getBestTimerBatchPath() != TimerBatchPath::Avx2) {
+                    continue;
+                }
+                registerBenchmark(std::string("TimerBatch/") + toString(path) + suffix,
+                    [=](State& state) { runBatch(state, path); });
+            }
+            registerBenchmark("TimerBatch/PerHandleQueries" + suffix, runPerHandle);
+            return true;
+        }
+
+        const bool timerBatchBenchmarksRegistered = registerTimerBatchBenchmarks();
+
+    } // namespace
+
+} // namespace LockedAndFlow::Bench
@@ -0,0 +1,145 @@
+#include "Benchmark.h"
+#include "Timer.h"
+#include <string>
+
+namespace LockedAndFlow::Bench {
+
+    namespace {
+
+        enum class Query {
+            GetElapsed,
+            GetRemainingTime,
+            GetProgressPercent,
+            Update
+        };
+
+        // Prepares a timer in the requested state with a far-off target so that
+        // the remaining/progress paths do full work and update() never auto-stops
+        void prepareTimer(Timer& timer, TimerState state, bool withObserver, Timer::Duration& sink) {
+            timer.setTargetDuration(std::chrono::hours(24));
+            if (withObserver) {
+                timer.subscribe([&sink](const TimerNotification& notification) { sink += notification.elapsed; });
+            }
+
+            switch (state) {
+            case TimerState::Running:
+                timer.start();
+                break;
+            case TimerState::Paused:
+                timer.start();
+                timer.pause();
+                break;
+            case TimerState::Stopped:
+                timer.start();
+                timer.stop();
+                break;
+            }
+        }
+
+        void runQuery(State& state, Query query, TimerState timerState, bool withObserver) {
+            Timer::Duration sink = Timer::Duration::zero();
+            Timer timer;
+            prepareTimer(timer, timerState, withObserver, sink);
+
+            switch (query) {
+            case Query::GetElapsed:
+                for (auto _ : state) {
+                    doNotOptimize(timer.getElapsed());
+                }
+                break;
+            case Query::GetRemainingTime:
+                for (auto _ : state) {
+                    doNotOptimize(timer.getRemainingTime());
+                }
+                break;
+            case Query::GetProgressPercent:
+                for (auto _ : state) {
+                    doNotOptimize(timer.getProgressPercent());
+                }
+                break;
+            case Query::Update:
+                for (auto _ : state) {
+                    timer.update();
+                }
+                break;
+            }
+
+            doNotOptimize(sink);
+        }
+
+        const char* queryName(Query query) {
+            switch (query) {
+            case Query::GetElapsed:         return "getElapsed";
+            case Query::GetRemainingTime:   return "getRemainingTime";
+            case Query::GetProgressPercent: return "getProgressPercent";
+            case Query::Update:             return "update";
+            }
+            return "unknown";
+        }
+
+        const char* stateName(TimerState state) {
+            switch (state) {
+            case TimerState::Running: return "Running";
+            case TimerState::Paused:  return "Paused";
+            case TimerState::Stopped: return "Stopped";
+            }
+            return "Unknown";
+        }
+
+        // Registers the full Query x State x Observer matrix
+        bool registerTimerBenchmarks() {
+            for (const Query query : { Query::GetElapsed, Query::GetRemainingTime,
+                                       Query::GetProgressPercent, Query::Update }) {
+                for (const TimerState timerState : { TimerState::Running, TimerState::Paused,
+                                                     TimerState::Stopped }) {
+                    for (const bool withObserver : { false, true }) {
+                        std::string name = std::string("Timer/") + queryName(query) + "/" +
+                            stateName(timerState) + (withObserver ? "/Observer" : "/NoObserver");
+
+                        registerBenchmark(std::move(name), [=](State& state) {
+                            runQuery(state, query, timerState, withObserver);
+                        });
+                    }
+                }
+            }
+            return true;
+        }
+
+        // One frame of main.cpp's timer work: each query samples the clock itself
+        void runFramePerQueryClock(State& state) {
+            Timer::Duration sink = Timer::Duration::zero();
+            Timer timer;
+            prepareTimer(timer, TimerState::Running, true, sink);
+
+            for (auto _ : state) {
+                timer.update();
+                doNotOptimize(timer.getElapsed());
+                doNotOptimize(timer.getRemainingTime());
+                doNotOptimize(timer.getProgressPercent());
+            }
+            doNotOptimize(sink);
+        }
+
+        // The same frame sharing a single clock sample
+        void runFrameSharedNow(State& state) {
+            Timer::Duration sink = Timer::Duration::zero();
+            Timer timer;
+            prepareTimer(timer, TimerState::Running, true, sink);
+
+            for (auto _ : state) {
+                const auto now = Timer::ClockType::now();
+                timer.update(now);
+                doNotOptimize(timer.getElapsed(now));
+                doNotOptimize(timer.getRemainingTime(now));
+                doNotOptimize(timer.getProgressPercent(now));
+            }
+            doNotOptimize(sink);
+        }
+
+        const bool timerBenchmarksRegistered = registerTimerBenchmarks();
+        const bool framePerQueryRegistered = registerBenchmark("TimerFrame/PerQueryClock", runFramePerQueryClock);
+        const bool frameSharedNowRegistered = registerBenchmark("TimerFrame/SharedNow", runFrameSharedNow);
+
+    } // namespace
+
+} // namespace LockedAndFlow::Bench
@@ -0,0 +1,79 @@
+#include "Benchmark.h"
+#include "MpscRing.h"
+#include "TimerCommandQueue.h"
+#include <atomic>
+#include <memory>
+#include <thread>
+#include <vector>
+
+namespace LockedAndFlow::Bench {
+
+    namespace {
+
+        struct Tagged {
+            std::uint32_t producer;
+            std::uint32_t sequence;
+        };
+
+        // Throughput: producers push flat out, the benchmark thread is the consumer
+        void runThroughput(State& state, std::size_t producers) {
+            auto ring = std::make_unique<MpscRing<Tagged, TimerCommandQueue::kCapacity>>();
+            std::atomic<bool> stop{ false };
+            std::vector<std::thread> threads;
+            for (std::size_t p = 0; p < producers; ++p) {
+                threads.emplace_back([&ring, &stop, p] {
+                    std::uint32_t sequence = 0;
+                    while (!stop.load(std::memory_order_relaxed)) {
+                        if (ring->tryPush(Tagged{ static_cast<std::uint32_t>(p), sequence })) {
+                            ++sequence;
+                        }
+                        else {
+                            std::this_thread::yield();
+                        }
+                    }
+                });
+            }
+
+            Tagged item{};
+            for (auto _ : state) {
+                while (!ring->tryPop(item)) {
+                    std::this_thread::yield(); // Keeps single-core machines from starving producers
+                }
+                doNotOptimize(item);
+            }
+
+            stop.store(true);
+            for (auto& thread : threads) {
+                thread.join();
+            }
+        }
+
+        // The owning thread's side: post + drain + apply on a single thread, no contention
+        void runPostAndApply(State& state) {
+            TimerCommandQueue queue;
+            Timer timer;
+            const auto now = Timer::ClockType::now();
+            std::size_t applied = 0;
+            for (auto _ : state) {
+                queue.post(TimerCommand{ TimerCommandType::Start, Timer::Duration::zero(), now });
+                queue.post(TimerCommand{ TimerCommandType::Pause, Timer::Duration::zero(), now });
+                applied += queue.drain([&](const TimerCommand& command) {
+                    TimerCommandQueue::apply(command, timer, now);
+                });
+            }
+            state.setItemsPerIteration(2);
+            doNotOptimize(applied);
+        }
+
+        bool registerTimerCommandQueueBenchmarks() {
+            registerBenchmark("MpscRing/throughput/1producer", [](State& state) { runThroughput(state, 1); });
+            registerBenchmark("MpscRing/throughput/4producers", [](State& state) { runThroughput(state, 4); });
+            registerBenchmark("TimerCommandQueue/postAndApply", runPostAndApply);
+            return true;
+        }
+
+        const bool timerCommandQueueBenchmarksRegistered = registerTimerCommandQueueBenchmarks();
+
+    } // namespace
+
+} // namespace LockedAndFlow::Bench
@@ -0,0 +1,129 @@
+#include "Benchmark.h"
+#include "TimerPool.h"
+#include <string>
+#include <vector>
+
+namespace LockedAndFlow::Bench {
+
+    namespace {
+
+        constexpr std::size_t kTimerCounts[] = { 1000, 10000, 100000 };
+
+        // Every timer running with a target that is never reached during the run
+        void runPoolUpdateAll(State& state, std::size_t timerCount) {
+            TimerPool pool;
+            pool.reserve(timerCount);
+
+            const auto start = std::chrono::steady_clock::now();
+            for (std::size_t i = 0; i < timerCount; ++i) {
+                const auto handle = pool.create();
+                pool.setTargetDuration(handle, std::chrono::hours(24));
+                pool.start(handle, start);
+            }
+
+            state.setItemsPerIteration(timerCount);
+            for (auto _ : state) {
+                doNotOptimize(pool.updateAll(std::chrono::steady_clock::now()));
+            }
+        }
+
+        // The pre-wheel updateAll(): a scan of every slot's state/start/elapsed/target
+        std::size_t linearScanExpired(const TimerPool& pool, TimerPool::TimePoint now) {
+            const TimerState* states = pool.stateData();
+            const TimerPool::TimePoint* startTimes = pool.startTimeData();
+            const TimerPool::Duration* totalElapsed = pool.totalElapsedData();
+            const TimerPool::Duration* targets = pool.targetData();
+            const std::uint8_t* hasTarget = pool.hasTargetData();
+
+            std::size_t expired = 0;
+            for (std::size_t index = 0; index < pool.slotCount(); ++index) {
+                if (states[index] == TimerState::Running && hasTarget[index] &&
+                    totalElapsed[index] + std::chrono::duration_cast<TimerPool::Duration>(now - startTimes[index]) >= targets[index]) {
+                    ++expired;
+                }
+            }
+            return expired;
+        }
+
+        void runPoolLinearScan(State& state, std::size_t timerCount) {
+            TimerPool pool;
+            pool.reserve(timerCount);
+
+            const auto start = std::chrono::steady_clock::now();
+            for (std::size_t i = 0; i < timerCount; ++i) {
+                const auto handle = pool.create();
+                pool.setTargetDuration(handle, std::chrono::hours(24));
+                pool.start(handle, start);
+            }
+
+            state.setItemsPerIteration(timerCount);
+            for (auto _ : state) {
+                doNotOptimize(linearScanExpired(pool, std::chrono::steady_clock::now()));
+            }
+        }
+
+        // Steady churn on simulated time: targets spread over a minute, each expired
+        // timer is restarted, and every update advances one 16 ms frame
+        void runPoolExpiryChurn(State& state, std::size_t timerCount) {
+            TimerPool pool;
+            pool.reserve(timerCount);
+
+            auto now = std::chrono::steady_clock::time_point(std::chrono::hours(1));
+            for (std::size_t i = 0; i < timerCount; ++i) {
+                const auto handle = pool.create();
+                pool.setTargetDuration(handle, std::chrono::milliseconds(1000 + (i * 7919) % 59000));
+                pool.start(handle, now);
+            }
+
+            std::vector<TimerPool::Handle> expired;
+            std::size_t restarted = 0;
+            for (auto _ : state) {
+                now += std::chrono::milliseconds(16);
+                expired.clear();
+                pool.updateAll(now, &expired);
+                for (const auto handle : expired) {
+                    pool.reset(handle);
+                    pool.start(handle, now);
+                }
+                restarted += expired.size();
+            }
+            doNotOptimize(restarted);
+        }
+
+        // Baseline: the same workload as a vector of Timer objects
+        void runTimerVectorUpdate(State& state, std::size_t timerCount) {
+            std::vector<Timer> timers(timerCount);
+            for (auto& timer : timers) {
+                timer.setTargetDuration(std::chrono::hours(24));
+                timer.start();
+            }
+
+            state.setItemsPerIteration(timerCount);
+            for (auto _ : state) {
+                for (auto& timer : timers) {
+                    timer.update();
+                }
+                doNotOptimize(timers.data());
+            }
+        }
+
+        bool registerTimerPoolBenchmarks() {
+            for (const auto timerCount : kTimerCounts) {
+                const auto suffix = "/" + std::to_string(timerCount);
+                registerBenchmark("TimerPool/updateAll" + suffix,
+                    [=](State& state) { runPoolUpdateAll(state, timerCount); });
+                registerBenchmark("TimerPool/linearScan" + suffix,
+                    [=](State& state) { runPoolLinearScan(state, timerCount); });
+                registerBenchmark("TimerPool/expiryChurn" + suffix,
+                    [=](State& state) { runPoolExpiryChurn(state, timerCount); });
+                registerBenchmark("TimerVector/update" + suffix,
+                    [=](State& state) { runTimerVectorUpdate(state, timerCount); });
+            }
+            return true;
+        }
+
+        const bool timerPoolBenchmarksRegistered = registerTimerPoolBenchmarks();
+
+    } // namespace
+
+} // namespace LockedAndFlow::Bench
@@ -0,0 +1,543 @@
+#include "TimerSimulation.h"
+#include "TimerBatch.h"
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+
+namespace LockedAndFlow::Bench {
+
+    namespace {
+
+        using Days = std::chrono::duration<long long, std::ratio<86400>>;
+
+        // User behaviour, tuned to look like a working day rather than noise
+        constexpr std::chrono::minutes kMeanRun{ 20 };
+        constexpr std::chrono::minutes kMeanPause{ 6 };
+        constexpr std::chrono::minutes kMeanBreak{ 15 };
+        constexpr double kTargetUserShare = 0.7;    // The rest never set a target
+
+        long long toMilliseconds(VirtualClock::time_point at) {
+            return static_cast<long long>(
+                std::chrono::duration_cast<std::chrono::milliseconds>(at.time_since_epoch()).count());
+        }
+
+    } // namespace
+
+    // Model
+
+    TimerSimulation::Duration TimerSimulation::Model::elapsedAt(TimePoint now) const noexcept {
+        if (state != TimerState::Running) {
+            return elapsed;
+        }
+        return elapsed + std::chrono::duration_cast<Duration>(now - runStart);
+    }
+
+    void TimerSimulation::Model::start(TimePoint now) noexcept {
+        if (state != TimerState::Running) {
+            state = TimerState::Running;
+            runStart = now;
+        }
+    }
+
+    void TimerSimulation::Model::pause(TimePoint now) noexcept {
+        if (state == TimerState::Running) {
+            endRun(now);
+            state = TimerState::Paused;
+        }
+    }
+
+    void TimerSimulation::Model::stop(TimePoint now) noexcept {
+        endRun(now);
+        state = TimerState::Stopped;
+    }
+
+    void TimerSimulation::Model::reset() noexcept {
+        state = TimerState::Stopped;
+        elapsed = Duration::zero();
+        exactElapsed = Clock::duration::zero();
+        runs = 0;
+    }
+
+    void TimerSimulation::Model::endRun(TimePoint now) noexcept {
+        if (state == TimerState::Running) {
+            elapsed += std::chrono::duration_cast<Duration>(now - runStart);
+            exactElapsed += now - runStart;
+            ++runs;
+        }
+    }
+
+    // Simulation
+
+    TimerSimulation::TimerSimulation(const SimulationConfig& config)
+        : config_(config)
+        , random_(config.seed) {
+        // Week 0, Monday 00:00
+        Clock::set(TimePoint{});
+
+        users_.resize(config_.users);
+        pool_.reserve(config_.users);
+        for (std::uint32_t index = 0; index < users_.size(); ++index) {
+            User& user = users_[index];
+            user.usesTargets = chance(kTargetUserShare);
+            if (config_.drivePool) {
+                user.handle = pool_.create(); // Slot index == user index
+            }
+            if (config_.driveTimers) {
+                user.timer.subscribe([this](const TimerNotification&) { ++stats_.targetNotifications; },
+                    TimerEvent::TargetReached);
+            }
+            events_.push({ TimePoint{} + std::chrono::hours(8) + uniform(Clock::duration::zero(), std::chrono::hours(3)),
+                EventKind::Action, index, 0 });
+        }
+
+        if (config_.verify && config_.sweepInterval.count() > 0) {
+            events_.push({ TimePoint{} + config_.sweepInterval, EventKind::Sweep, 0, 0 });
+        }
+    }
+
+    void TimerSimulation::runFor(Clock::duration span) {
+        const TimePoint end = Clock::now() + span;
+        for (;;) {
+            // Wake for the next user event, or for the pool's next expiry as the daemon would
+            TimePoint next = end;
+            if (!events_.empty()) {
+                next = std::min(next, events_.top().at);
+            }
+            if (config_.drivePool) {
+                if (const auto deadline = pool_.nextDeadline()) {
+                    next = std::min(next, std::max(*deadline, Clock::now()));
+                }
+            }
+            if (next >= end) {
+                break;
+            }
+
+            Clock::set(next);
+            ++stats_.events;
+            if (config_.drivePool) {
+                expired_.clear();
+                pool_.updateAll(next, &expired_);
+                for (const TimerPool::Handle handle : expired_) {
+                    handlePoolExpiry(handle.index, next);
+                }
+            }
+
+            if (events_.empty() || events_.top().at != next) {
+                continue;
+            }
+            const Event event = events_.top();
+            events_.pop();
+            switch (event.kind) {
+            case EventKind::Expiry:
+                if (event.generation == users_[event.user].generation) {
+                    handleExpiry(event.user, next);
+                }
+                break;
+            case EventKind::Action:
+                handleAction(event.user, next);
+                break;
+            case EventKind::Sweep:
+                handleSweep(next);
+                break;
+            }
+        }
+
+        Clock::set(end);
+        stats_.simulated += span;
+        if (config_.verify && config_.driveTimers && stats_.targetNotifications != stats_.expiries) {
+            fail(kNoUser, "Timer", "TargetReached notifications",
+                static_cast<long long>(stats_.expiries), static_cast<long long>(stats_.targetNotifications));
+        }
+    }
+
+    double TimerSimulation::uniform() {
+        // 53 random bits: the same value from every standard library
+        return static_cast<double>(random_() >> 11) * 0x1.0p-53;
+    }
+
+    TimerSimulation::Clock::duration TimerSimulation::uniform(Clock::duration low, Clock::duration high) {
+        return low + Clock::duration(static_cast<Clock::rep>(uniform() * static_cast<double>((high - low).count())));
+    }
+
+    TimerSimulation::Clock::duration TimerSimulation::exponential(Clock::duration mean) {
+        return Clock::duration(static_cast<Clock::rep>(-std::log1p(-uniform()) * static_cast<double>(mean.count())));
+    }
+
+    TimerSimulation::TimePoint TimerSimulation::nextWorkdayStart(TimePoint after) {
+        auto day = std::chrono::duration_cast<Days>(after.time_since_epoch()).count() + 1;
+        while (day % 7 >= 5) {
+            ++day; // Weekend
+        }
+        return TimePoint{} + Days(day) + std::chrono::hours(8) + uniform(Clock::duration::zero(), std::chrono::hours(3));
+    }
+
+    TimerSimulation::Duration TimerSimulation::chooseTarget() {
+        if (chance(0.7)) {
+            return chance(0.75) ? std::chrono::minutes(25) : std::chrono::minutes(50); // Pomodoro
+        }
+        // Anything from a millisecond to two hours, often below what has already elapsed
+        return std::chrono::duration_cast<Duration>(uniform(std::chrono::milliseconds(1), std::chrono::hours(2)));
+    }
+
+    void TimerSimulation::handleAction(std::uint32_t index, TimePoint now) {
+        User& user = users_[index];
+        Model& model = user.model;
+        ++stats_.actions;
+
+        // A due target expires before any action at the same instant
+        if (config_.verify && model.state == TimerState::Running && model.target &&
+            model.elapsedAt(now) >= *model.target) {
+            fail(index, "model", "target passed without expiring",
+                static_cast<long long>(model.target->count()), static_cast<long long>(model.elapsedAt(now).count()));
+        }
+        if (config_.driveTimers) {
+            user.timer.update(); // As the app does every frame; nothing is due
+        }
+
+        const bool dayOver = now >= user.dayEnd;
+        switch (model.state) {
+        case TimerState::Stopped:
+            if (dayOver) {
+                user.dayEnd = now + uniform(std::chrono::hours(6), std::chrono::hours(10));
+            }
+            if (model.target && model.elapsed >= *model.target && chance(0.95)) {
+                reset(user); // A fresh session after a finished one; the rest expire again at once
+            }
+            if (user.usesTargets && (!model.target || chance(0.5))) {
+                setTarget(user, chooseTarget());
+            }
+            start(user, now);
+            break;
+
+        case TimerState::Running: {
+            if (dayOver) {
+                stop(user, now);
+                if (chance(0.3)) {
+                    reset(user);
+                }
+                break;
+            }
+            const double choice = uniform();
+            if (choice < 0.45) {
+                pause(user, now);
+            }
+            else if (choice < 0.75) {
+                stop(user, now);
+            }
+            else if (choice < 0.9 && user.usesTargets) {
+                setTarget(user, chooseTarget());
+            }
+            else {
+                reset(user);
+            }
+            break;
+        }
+
+        case TimerState::Paused: {
+            const double choice = uniform();
+            if (dayOver || (choice >= 0.7 && choice < 0.9)) {
+                stop(user, now);
+            }
+            else if (choice < 0.7) {
+                start(user, now);
+            }
+            else {
+                reset(user);
+            }
+            break;
+        }
+        }
+
+        scheduleAction(index, now);
+        scheduleExpiry(index, now);
+        if (config_.verify) {
+            verify(index, now);
+        }
+    }
+
+    void TimerSimulation::handleExpiry(std::uint32_t index, TimePoint now) {
+        User& user = users_[index];
+        Model& model = user.model;
+        if (model.state != TimerState::Running || !model.target || model.elapsedAt(now) < *model.target) {
+            fail(index, "model", "expiry scheduled before the target",
+                static_cast<long long>(model.target.value_or(Duration::zero()).count()),
+                static_cast<long long>(model.elapsedAt(now).count()));
+        }
+
+        user.timer.update();
+        if (!user.timer.isStopped()) {
+            fail(index, "Timer", "still running at its target deadline",
+                static_cast<long long>(model.target->count()), static_cast<long long>(user.timer.getElapsed().count()));
+        }
+        if (config_.drivePool && user.poolExpiredAt != now) {
+            fail(index, "TimerPool", "did not expire with Timer (expiry ms)", toMilliseconds(now),
+                user.poolExpiredAt ? toMilliseconds(*user.poolExpiredAt) : -1);
+        }
+        user.poolExpiredAt.reset();
+        model.stop(now);
+        user.expiryAt.reset();
+        ++stats_.expiries;
+
+        if (config_.verify) {
+            if (user.expiryOnTarget && model.elapsed != *model.target) {
+                fail(index, "model", "expiry did not land on the target",
+                    static_cast<long long>(model.target->count()), static_cast<long long>(model.elapsed.count()));
+            }
+            verify(index, now);
+        }
+    }
+
+    void TimerSimulation::handlePoolExpiry(std::uint32_t index, TimePoint now) {
+        User& user = users_[index];
+        if (config_.driveTimers) {
+            user.poolExpiredAt = now; // The Timer's expiry event at this instant checks it
+            return;
+        }
+
+        Model& model = user.model;
+        if (model.state != TimerState::Running || !model.target || model.elapsedAt(now) < *model.target) {
+            fail(index, "TimerPool", "expired before its target",
+                static_cast<long long>(model.target.value_or(Duration::zero()).count()),
+                static_cast<long long>(model.elapsedAt(now).count()));
+        }
+        model.stop(now);
+        user.expiryAt.reset();
+        ++stats_.expiries;
+
+        if (config_.verify) {
+            if (user.expiryOnTarget && model.elapsed != *model.target) {
+                fail(index, "TimerPool", "expiry did not land on the target",
+                    static_cast<long long>(model.target->count()), static_cast<long long>(model.elapsed.count()));
+            }
+            verify(index, now);
+        }
+    }
+
+    void TimerSimulation::handleSweep(TimePoint now) {
+        ++stats_.sweeps;
+        for (std::uint32_t index = 0; index < users_.size(); ++index) {
+            verify(index, now);
+        }
+        if (config_.driveTimers && config_.drivePool) {
+            verifyBatch(now);
+        }
+        events_.push({ now + config_.sweepInterval, EventKind::Sweep, 0, 0 });
+    }
+
+    void TimerSimulation::start(User& user, TimePoint now) {
+        ++stats_.operations;
+        user.model.start(now);
+        if (config_.driveTimers) {
+            user.timer.start(); // Reads VirtualClock
+        }
+        if (config_.drivePool) {
+            pool_.start(user.handle, now);
+        }
+    }
+
+    void TimerSimulation::pause(User& user, TimePoint now) {
+        ++stats_.operations;
+        user.model.pause(now);
+        if (config_.driveTimers) {
+            user.timer.pause();
+        }
+        if (config_.drivePool) {
+            pool_.pause(user.handle, now);
+        }
+    }
+
+    void TimerSimulation::stop(User& user, TimePoint now) {
+        ++stats_.operations;
+        user.model.stop(now);
+        if (config_.driveTimers) {
+            user.timer.stop();
+        }
+        if (config_.drivePool) {
+            pool_.stop(user.handle, now);
+        }
+    }
+
+    void TimerSimulation::reset(User& user) {
+        ++stats_.operations;
+        user.model.reset();
+        user.lastElapsed = Duration::zero();
+        if (config_.driveTimers) {
+            user.timer.reset();
+        }
+        if (config_.drivePool) {
+            pool_.reset(user.handle);
+        }
+    }
+
+    void TimerSimulation::setTarget(User& user, Duration target) {
+        ++stats_.operations;
+        user.model.target = target;
+        if (config_.driveTimers) {
+            user.timer.setTargetDuration(target);
+        }
+        if (config_.drivePool) {
+            pool_.setTargetDuration(user.handle, target);
+        }
+    }
+
+    void TimerSimulation::scheduleAction(std::uint32_t index, TimePoint now) {
+        User& user = users_[index];
+        TimePoint next;
+        switch (user.model.state) {
+        case TimerState::Running:
+            next = std::min(now + exponential(kMeanRun), user.dayEnd);
+            break;
+        case TimerState::Paused:
+            next = std::min(now + exponential(kMeanPause), user.dayEnd);
+            break;
+        case TimerState::Stopped:
+        default:
+            next = now + exponential(kMeanBreak);
+            if (next >= user.dayEnd) {
+                next = nextWorkdayStart(now);
+            }
+            break;
+        }
+        events_.push({ next, EventKind::Action, index, 0 });
+    }
+
+    void TimerSimulation::scheduleExpiry(std::uint32_t index, TimePoint now) {
+        User& user = users_[index];
+        const Model& model = user.model;
+        ++user.generation; // Any earlier expiry event is stale
+        user.expiryAt.reset();
+        if (model.state != TimerState::Running || !model.target) {
+            return;
+        }
+
+        // The instant elapsed reaches the target; a target lowered below elapsed is due now
+        const TimePoint deadline = model.runStart + (*model.target - model.elapsed);
+        user.expiryOnTarget = deadline >= now;
+        user.expiryAt = std::max(deadline, now);
+        if (config_.driveTimers) {
+            events_.push({ *user.expiryAt, EventKind::Expiry, index, user.generation });
+        }
+    }
+
+    void TimerSimulation::verify(std::uint32_t index, TimePoint now) {
+        User& user = users_[index];
+        if (user.poolExpiredAt) {
+            fail(index, "Timer", "did not expire with TimerPool (expiry ms)",
+                toMilliseconds(*user.poolExpiredAt), -1);
+        }
+
+        if (config_.driveTimers) {
+            const SimulatedTimer& timer = user.timer;
+            verifyQueries(index, "Timer", timer.getState(), timer.getElapsed(), timer.getRemainingTime(),
+                timer.getProgressPercent());
+            if (timer.getElapsed() != timer.getElapsed(now) || timer.getSnapshot().getElapsed(now) != timer.getElapsed(now)) {
+                fail(index, "Timer", "clock overloads disagree", static_cast<long long>(timer.getElapsed(now).count()),
+                    static_cast<long long>(timer.getElapsed().count()));
+            }
+        }
+        if (config_.drivePool) {
+            verifyQueries(index, "TimerPool", pool_.getState(user.handle), pool_.getElapsed(user.handle, now),
+                pool_.getRemainingTime(user.handle, now), pool_.getProgressPercent(user.handle, now));
+        }
+        user.lastElapsed = user.model.elapsedAt(now);
+    }
+
+    void TimerSimulation::verifyQueries(std::uint32_t index, const char* subject, TimerState state,
+        Duration elapsed, std::optional<Duration> remaining, float progress) {
+        const User& user = users_[index];
+        const Model& model = user.model;
+        const TimePoint now = Clock::now();
+        const bool running = model.state == TimerState::Running;
+        ++stats_.checks;
+
+        if (state != model.state) {
+            fail(index, subject, "state", static_cast<long long>(model.state), static_cast<long long>(state));
+        }
+        const Duration expected = model.elapsedAt(now);
+        if (elapsed != expected) {
+            fail(index, subject, "getElapsed()", static_cast<long long>(expected.count()),
+                static_cast<long long>(elapsed.count()));
+        }
+        if (elapsed < user.lastElapsed) {
+            fail(index, subject, "getElapsed() went backwards without a reset",
+                static_cast<long long>(user.lastElapsed.count()), static_cast<long long>(elapsed.count()));
+        }
+
+        // Truncation: never ahead of the true running time, behind by under 1 ms per run
+        const Clock::duration exact = model.exactElapsed + (running ? now - model.runStart : Clock::duration::zero());
+        const Clock::duration behind = exact - std::chrono::duration_cast<Clock::duration>(elapsed);
+        const auto terms = static_cast<Clock::rep>(model.runs + (running ? 1 : 0));
+        if (behind < Clock::duration::zero() || (terms > 0 && behind >= std::chrono::milliseconds(terms))) {
+            fail(index, subject, "getElapsed() off the true running time (ns)",
+                static_cast<long long>(exact.count()), static_cast<long long>(elapsed.count()) * 1000000);
+        }
+
+        if (remaining.has_value() != model.target.has_value()) {
+            fail(index, subject, "getRemainingTime() presence", model.target.has_value(), remaining.has_value());
+        }
+        if (model.target) {
+            const Duration target = *model.target;
+            const Duration expectedRemaining = SimulatedTimer::remainingFor(expected, target);
+            if (*remaining != expectedRemaining || *remaining > target || *remaining < Duration::zero() ||
+                (*remaining > Duration::zero() && elapsed + *remaining != target)) {
+                fail(index, subject, "getRemainingTime()", static_cast<long long>(expectedRemaining.count()),
+                    static_cast<long long>(remaining->count()));
+            }
+            const bool expiryDue = user.expiryAt && *user.expiryAt <= now; // Expires later this instant
+            if (running && *remaining == Duration::zero() && !expiryDue) {
+                fail(index, subject, "running with no time remaining", static_cast<long long>(target.count()),
+                    static_cast<long long>(elapsed.count()));
+            }
+        }
+
+        const float expectedProgress = model.target ? SimulatedTimer::progressPercentFor(expected, *model.target) : 0.0f;
+        if (progress != expectedProgress || progress < 0.0f || progress > 100.0f) {
+            fail(index, subject, "getProgressPercent() (x1000)", std::llround(expectedProgress * 1000.0f),
+                std::llround(progress * 1000.0f));
+        }
+    }
+
+    void TimerSimulation::verifyBatch(TimePoint now) {
+        const TimerBatchInput input = pool_.getBatchInput();
+        batchElapsed_.resize(input.count);
+        batchRemaining_.resize(input.count);
+        batchProgress_.resize(input.count);
+        const TimerBatchOutput output{ batchElapsed_.data(), batchRemaining_.data(), batchProgress_.data() };
+
+        for (const TimerBatchPath path : { TimerBatchPath::Scalar, getBestTimerBatchPath() }) {
+            evaluateTimerBatch(input, now, output, path);
+            for (std::uint32_t index = 0; index < users_.size(); ++index) {
+                const SimulatedTimer& timer = users_[index].timer;
+                const std::uint32_t slot = users_[index].handle.index;
+                if (batchElapsed_[slot] != timer.getElapsed(now)) {
+                    fail(index, toString(path), "batch elapsed", static_cast<long long>(timer.getElapsed(now).count()),
+                        static_cast<long long>(batchElapsed_[slot].count()));
+                }
+                const Duration remaining = timer.getRemainingTime(now).value_or(Duration::zero());
+                if (batchRemaining_[slot] != remaining) {
+                    fail(index, toString(path), "batch remaining", static_cast<long long>(remaining.count()),
+                        static_cast<long long>(batchRemaining_[slot].count()));
+                }
+                if (batchProgress_[slot] != timer.getProgressPercent(now)) {
+                    fail(index, toString(path), "batch progress (x1000)", std::llround(timer.getProgressPercent(now) * 1000.0f),
+                        std::llround(batchProgress_[slot] * 1000.0f));
+                }
+            }
+        }
+    }
+
+    void TimerSimulation::fail(std::uint32_t index, const char* subject, const char* what,
+        long long expected, long long actual) const {
+        char user[16] = "-";
+        if (index != kNoUser) {
+            std::snprintf(user, sizeof(user), "%u", static_cast<unsigned>(index));
+        }
+        std::fprintf(stderr,
+            "Simulation invariant violated (seed %llu, user %s, t = %lld ms): %s %s: expected %lld, got %lld\n",
+            static_cast<unsigned long long>(config_.seed), user, toMilliseconds(Clock::now()), subject, what,
+            expected, actual);
+        std::abort();
+    }
+
+} // namespace LockedAndFlow::Bench
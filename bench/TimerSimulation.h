@@ -0,0 +1,184 @@
+#pragma once
+
+#include "Timer.h"
+#include "TimerPool.h"
+#include "VirtualClock.h"
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <optional>
+#include <queue>
+#include <random>
+#include <vector>
+
+namespace LockedAndFlow::Bench {
+
+    struct SimulationConfig {
+        std::size_t users = 1000;
+        std::uint64_t seed = 1;
+        bool driveTimers = true;    // One BasicTimer<VirtualClock> per user
+        bool drivePool = true;      // One TimerPool timer per user
+        bool verify = true;         // Check every touched timer against a reference model
+        // How often every timer is checked, and the pool's batch evaluation compared
+        // with Timer when both are driven; zero disables the sweep
+        std::chrono::minutes sweepInterval{ 60 };
+    };
+
+    struct SimulationStats {
+        std::uint64_t events = 0;           // Scheduler wakeups
+        std::uint64_t actions = 0;          // User actions (each one or two timer operations)
+        std::uint64_t operations = 0;       // start/pause/stop/reset/setTargetDuration calls
+        std::uint64_t expiries = 0;         // Targets reached
+        std::uint64_t sweeps = 0;
+        std::uint64_t checks = 0;           // Timers verified against the model
+        std::uint64_t targetNotifications = 0;
+        VirtualClock::duration simulated{ 0 };
+    };
+
+    /**
+     * @brief Seeded load generator replaying users' timer sessions on a VirtualClock
+     *
+     * Each user works weekdays (a start between 08:00 and 11:00 and a 6-10
+     * hour day), starting, pausing, stopping, resetting and retargeting a timer
+     * at exponentially distributed intervals, often with a Pomodoro-style
+     * target. Events run in time order on one thread and jump the clock from one
+     * event to the next, so months of simulated time take seconds. The same
+     * seed replays the same sequence on any platform (the distributions are
+     * computed here rather than by <random>).
+     *
+     * Targets expire the way the app and daemon see them: Timer through
+     * update() at the exact deadline, TimerPool through updateAll() when its
+     * nextDeadline() comes due. With verify on, every timer a step touches is
+     * compared with a reference model (state, elapsed, remaining, progress),
+     * the pool with Timer, and on each sweep the pool's evaluateTimerBatch()
+     * output with Timer. Any mismatch prints the seed, user and instant and
+     * aborts.
+     *
+     * VirtualClock is process-wide, so only one simulation may run at a time.
+     */
+    class TimerSimulation {
+    public:
+        using Clock = VirtualClock;
+        using SimulatedTimer = BasicTimer<VirtualClock>;
+
+        explicit TimerSimulation(const SimulationConfig& config);
+        TimerSimulation(const TimerSimulation&) = delete;
+        TimerSimulation& operator=(const TimerSimulation&) = delete;
+
+        // Processes every event before now() + @p span, then moves the clock there
+        void runFor(Clock::duration span);
+
+        Clock::time_point now() const noexcept { return Clock::now(); }
+        const SimulationConfig& getConfig() const noexcept { return config_; }
+        const SimulationStats& getStats() const noexcept { return stats_; }
+
+    private:
+        using Duration = Timer::Duration;
+        using TimePoint = Clock::time_point;
+
+        static constexpr std::uint32_t kNoUser = ~std::uint32_t{ 0 };
+
+        enum class EventKind : std::uint8_t {
+            Expiry,     // A running Timer's target deadline (before actions at the same instant)
+            Action,
+            Sweep
+        };
+
+        struct Event {
+            TimePoint at;
+            EventKind kind;
+            std::uint32_t user;
+            std::uint32_t generation;   // Expiry events go stale when the user acts again
+
+            bool operator>(const Event& other) const noexcept {
+                if (at != other.at) {
+                    return at > other.at;
+                }
+                if (kind != other.kind) {
+                    return kind > other.kind;
+                }
+                return user > other.user;
+            }
+        };
+
+        // What the timer should report, from the documented rules: elapsed is the
+        // sum of each run's whole milliseconds, a timer stops when update() finds
+        // elapsed at or past its target
+        struct Model {
+            TimerState state = TimerState::Stopped;
+            Duration elapsed{ 0 };                  // Completed runs since the last reset
+            Clock::duration exactElapsed{ 0 };      // The same runs without truncation
+            std::uint32_t runs = 0;
+            TimePoint runStart{};
+            std::optional<Duration> target;
+
+            Duration elapsedAt(TimePoint now) const noexcept;
+            void start(TimePoint now) noexcept;
+            void pause(TimePoint now) noexcept;
+            void stop(TimePoint now) noexcept;
+            void reset() noexcept;
+            void endRun(TimePoint now) noexcept;    // Running -> adds the run
+        };
+
+        struct User {
+            SimulatedTimer timer;
+            TimerPool::Handle handle;
+            Model model;
+            bool usesTargets = false;
+            TimePoint dayEnd{};
+            std::uint32_t generation = 0;
+            std::optional<TimePoint> expiryAt;      // When the running timer's target comes due
+            bool expiryOnTarget = false;            // Deadline was not already past when scheduled
+            std::optional<TimePoint> poolExpiredAt; // Pool stopped it; Timer must follow at once
+            Duration lastElapsed{ 0 };
+        };
+
+        SimulationConfig config_;
+        SimulationStats stats_;
+        std::mt19937_64 random_;
+        std::vector<User> users_;
+        TimerPool pool_;
+        std::priority_queue<Event, std::vector<Event>, std::greater<>> events_;
+        std::vector<TimerPool::Handle> expired_;
+
+        // Batch evaluation scratch for sweeps
+        std::vector<Duration> batchElapsed_;
+        std::vector<Duration> batchRemaining_;
+        std::vector<float> batchProgress_;
+
+        // Portable draws from random_
+        double uniform();
+        Clock::duration uniform(Clock::duration low, Clock::duration high);
+        Clock::duration exponential(Clock::duration mean);
+        bool chance(double probability) { return uniform() < probability; }
+
+        TimePoint nextWorkdayStart(TimePoint after);
+        Duration chooseTarget();
+
+        void handleAction(std::uint32_t index, TimePoint now);
+        void handleExpiry(std::uint32_t index, TimePoint now);
+        void handlePoolExpiry(std::uint32_t index, TimePoint now);
+        void handleSweep(TimePoint now);
+
+        // Operations applied to the model, the Timer and the pool alike
+        void start(User& user, TimePoint now);
+        void pause(User& user, TimePoint now);
+        void stop(User& user, TimePoint now);
+        void reset(User& user);
+        void setTarget(User& user, Duration target);
+
+        void scheduleAction(std::uint32_t index, TimePoint now);
+        void scheduleExpiry(std::uint32_t index, TimePoint now);
+
+        // Checks the user's Timer and pool timer against the model
+        void verify(std::uint32_t index, TimePoint now);
+        void verifyQueries(std::uint32_t index, const char* subject, TimerState state,
+            Duration elapsed, std::optional<Duration> remaining, float progress);
+        void verifyBatch(TimePoint now);
+
+        [[noreturn]] void fail(std::uint32_t index, const char* subject, const char* what,
+            long long expected, long long actual) const;
+    };
+
+} // namespace LockedAndFlow::Bench
@@ -0,0 +1,95 @@
+#include "Benchmark.h"
+#include "Timer.h"
+#include <atomic>
+#include <cstdio>
+#include <cstdlib>
+#include <thread>
+
+namespace LockedAndFlow::Bench {
+
+    namespace {
+
+        // Reader cost with no concurrent writes: copy the snapshot and derive progress
+        void runReadUncontended(State& state) {
+            Timer timer;
+            Timer::Publisher publisher;
+            timer.setPublisher(&publisher);
+            timer.setTargetDuration(std::chrono::minutes(25));
+            timer.start();
+
+            const auto now = Timer::ClockType::now();
+            float sum = 0.0f;
+            for (auto _ : state) {
+                sum += publisher.read().getProgressPercent(now);
+            }
+            doNotOptimize(sum);
+        }
+
+        // Torn-read stress plus reader throughput: a writer thread publishes snapshots whose
+        // fields all encode the same counter, the benchmark thread reads and checks them
+        void runReadWithWriter(State& state) {
+            Timer::Publisher publisher;
+            std::atomic<bool> stop{ false };
+            std::thread writer([&] {
+                Timer::Snapshot snapshot;
+                snapshot.hasTarget = true;
+                for (std::int64_t counter = 1; !stop.load(std::memory_order_relaxed); ++counter) {
+                    snapshot.state = counter % 2 ? TimerState::Running : TimerState::Paused;
+                    snapshot.startTime = Timer::TimePoint(std::chrono::milliseconds(counter));
+                    snapshot.totalElapsed = Timer::Duration(counter);
+                    snapshot.target = Timer::Duration(counter);
+                    publisher.write(snapshot);
+                    if (counter % 64 == 0) {
+                        std::this_thread::yield(); // Lets the reader run on single-core machines
+                    }
+                }
+            });
+
+            std::int64_t last = 0;
+            for (auto _ : state) {
+                const Timer::Snapshot snapshot = publisher.read();
+                const std::int64_t counter = snapshot.totalElapsed.count();
+                const bool consistent = snapshot.target.count() == counter &&
+                    snapshot.startTime == Timer::TimePoint(std::chrono::milliseconds(counter)) &&
+                    (counter == 0 || snapshot.state == (counter % 2 ? TimerState::Running : TimerState::Paused));
+                if (!consistent || counter < last) {
+                    std::fprintf(stderr, "Seqlock stress failure: torn or stale snapshot at counter %lld\n",
+                        static_cast<long long>(counter));
+                    std::abort();
+                }
+                last = counter;
+            }
+
+            stop.store(true);
+            writer.join();
+        }
+
+        // Owner-side cost of publishing: a full pause/start cycle with a publisher attached
+        void runPublishingTimer(State& state, bool attached) {
+            Timer timer;
+            Timer::Publisher publisher;
+            if (attached) {
+                timer.setPublisher(&publisher);
+            }
+            auto now = Timer::ClockType::now();
+            for (auto _ : state) {
+                timer.start(now);
+                now += std::chrono::milliseconds(1);
+                timer.pause(now);
+            }
+            doNotOptimize(timer.getTotalElapsed());
+        }
+
+        bool registerTimerSnapshotBenchmarks() {
+            registerBenchmark("TimerSnapshot/read/uncontended", runReadUncontended);
+            registerBenchmark("TimerSnapshot/read/withWriter", runReadWithWriter);
+            registerBenchmark("TimerSnapshot/startPause/noPublisher", [](State& state) { runPublishingTimer(state, false); });
+            registerBenchmark("TimerSnapshot/startPause/publisher", [](State& state) { runPublishingTimer(state, true); });
+            return true;
+        }
+
+        const bool timerSnapshotBenchmarksRegistered = registerTimerSnapshotBenchmarks();
+
+    } // namespace
+
+} // namespace LockedAndFlow::Bench
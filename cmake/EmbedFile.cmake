@@ -0,0 +1,44 @@
+# Writes a C++ source that embeds a file as a constexpr byte array, returned by
+#   LockedAndFlow::EmbeddedFile LockedAndFlow::<FUNCTION>() noexcept
+# (declared in src/EmbeddedFile.h). Run in script mode:
+#   cmake -DINPUT=<file> -DOUTPUT=<source.cpp> -DFUNCTION=<name> -P EmbedFile.cmake
+
+foreach(variable INPUT OUTPUT FUNCTION)
+    if(NOT DEFINED ${variable})
+        message(FATAL_ERROR "EmbedFile.cmake: ${variable} is required")
+    endif()
+endforeach()
+
+file(READ "${INPUT}" hex HEX)
+string(LENGTH "${hex}" hexLength)
+math(EXPR size "${hexLength} / 2")
+
+# "0x..," per byte, sixteen bytes per line
+string(REGEX REPLACE "([0-9a-f][0-9a-f])" "0x\\1," bytes "${hex}")
+string(REGEX REPLACE "((0x[0-9a-f][0-9a-f],){16})" "\\1\n            " bytes "${bytes}")
+
+get_filename_component(inputName "${INPUT}" NAME)
+file(WRITE "${OUTPUT}.tmp"
+"// Generated by cmake/EmbedFile.cmake from ${inputName} (${size} bytes). Do not edit.
+#include \"EmbeddedFile.h\"
+
+namespace LockedAndFlow {
+
+    namespace {
+
+        alignas(8) constexpr unsigned char kData[] = {
+            ${bytes}
+        };
+
+    } // namespace
+
+    EmbeddedFile ${FUNCTION}() noexcept {
+        return { kData, sizeof(kData) };
+    }
+
+} // namespace LockedAndFlow
+")
+
+# Only touch the output when it changed, so dependents do not rebuild needlessly
+configure_file("${OUTPUT}.tmp" "${OUTPUT}" COPYONLY)
+file(REMOVE "${OUTPUT}.tmp")
@@ -0,0 +1,91 @@
+#include "ClockGlyphAtlas.h"
+#include <algorithm>
+#include <cmath>
+#include <memory>
+#include <vector>
+
+namespace LockedAndFlow {
+
+    namespace {
+
+        constexpr char kClockGlyphs[] = "0123456789:";
+        constexpr int kGlyphCount = sizeof(kClockGlyphs) - 1;
+
+        // Transparent border around every cell so smoothing never samples a neighbour
+        constexpr unsigned int kGutter = 1;
+
+    } // namespace
+
+    const ClockGlyphAtlas& ClockGlyphAtlas::get(const sf::Font& font, unsigned int characterSize) {
+        static std::vector<std::unique_ptr<ClockGlyphAtlas>> atlases;
+        for (const auto& atlas : atlases) {
+            if (atlas->font_ == &font && atlas->characterSize_ == characterSize) {
+                return *atlas;
+            }
+        }
+        atlases.push_back(std::make_unique<ClockGlyphAtlas>(font, characterSize));
+        return *atlases.back();
+    }
+
+    ClockGlyphAtlas::ClockGlyphAtlas(const sf::Font& font, unsigned int characterSize)
+        : font_(&font)
+        , characterSize_(characterSize) {
+
+        // Load every glyph before reading the page back: each load may grow it
+        std::array<sf::Glyph, kGlyphCount> glyphs;
+        float advance = 0.0f;
+        float top = 0.0f;
+        float bottom = 0.0f;
+        for (int i = 0; i < kGlyphCount; ++i) {
+            glyphs[i] = font.getGlyph(static_cast<char32_t>(kClockGlyphs[i]), characterSize, false);
+            advance = std::max(advance, glyphs[i].advance);
+            top = std::min(top, glyphs[i].bounds.position.y);
+            bottom = std::max(bottom, glyphs[i].bounds.position.y + glyphs[i].bounds.size.y);
+        }
+
+        // Baseline where sf::Text puts it, lowered only for glyphs taller than the character size
+        const float baseline = std::max(static_cast<float>(characterSize), -top);
+        const sf::Vector2u cell(static_cast<unsigned int>(std::ceil(advance)),
+                                static_cast<unsigned int>(std::ceil(baseline + bottom)));
+        if (cell.x == 0 || cell.y == 0) {
+            return; // No font loaded: readouts stay empty
+        }
+
+        const sf::Image page = font.getTexture(characterSize).copyToImage();
+        const unsigned int stride = cell.x + 2 * kGutter;
+        sf::Image image({ stride * kCellCount, cell.y + 2 * kGutter }, sf::Color(255, 255, 255, 0));
+
+        for (int i = 0; i < kCellCount; ++i) {
+            const unsigned int cellX = static_cast<unsigned int>(i) * stride + kGutter;
+            textureRects_[i] = sf::FloatRect({ static_cast<float>(cellX), static_cast<float>(kGutter) }, sf::Vector2f(cell));
+            if (i >= kGlyphCount) {
+                continue; // Blank cell
+            }
+
+            // Centre the glyph's advance box in the cell, clipping anything that overhangs it
+            const sf::Glyph& glyph = glyphs[i];
+            const int x = static_cast<int>(std::lround((static_cast<float>(cell.x) - glyph.advance) / 2.0f + glyph.bounds.position.x));
+            const int y = static_cast<int>(std::lround(baseline + glyph.bounds.position.y));
+            for (int row = 0; row < glyph.textureRect.size.y; ++row) {
+                for (int column = 0; column < glyph.textureRect.size.x; ++column) {
+                    const int cellColumn = x + column;
+                    const int cellRow = y + row;
+                    if (cellColumn < 0 || cellRow < 0 || cellColumn >= static_cast<int>(cell.x) || cellRow >= static_cast<int>(cell.y)) {
+                        continue;
+                    }
+                    const sf::Vector2u source(static_cast<unsigned int>(glyph.textureRect.position.x + column),
+                                              static_cast<unsigned int>(glyph.textureRect.position.y + row));
+                    image.setPixel({ cellX + static_cast<unsigned int>(cellColumn), kGutter + static_cast<unsigned int>(cellRow) },
+                                   page.getPixel(source));
+                }
+            }
+        }
+
+        if (!texture_.loadFromImage(image)) {
+            return;
+        }
+        texture_.setSmooth(font.isSmooth());
+        cellSize_ = sf::Vector2f(cell);
+    }
+
+} // namespace LockedAndFlow
@@ -0,0 +1,56 @@
+#pragma once
+
+#include <SFML/Graphics.hpp>
+#include <array>
+
+namespace LockedAndFlow {
+
+    /**
+     * @brief The glyphs of a clock readout baked into one fixed-cell texture
+     *
+     * Renders '0'-'9' and ':' of one font at one character size once, each
+     * centred in an equal-sized cell (as wide as the widest of them), plus a
+     * blank cell for any other character. Because every cell has the same size
+     * and baseline, a ClockReadout changes a character by rewriting the texture
+     * coordinates of its quad; positions never move.
+     *
+     * Atlases are shared: get() bakes on first use for each (font, size) and
+     * keeps them for the life of the program. Baking reads the font's glyph
+     * page back from the GPU, so the first get() needs an OpenGL context (any
+     * window or RenderTexture).
+     */
+    class ClockGlyphAtlas {
+    public:
+        static constexpr int kDigitCells = 10;
+        static constexpr int kColonCell = 10;
+        static constexpr int kBlankCell = 11;
+        static constexpr int kCellCount = 12;
+
+        static const ClockGlyphAtlas& get(const sf::Font& font, unsigned int characterSize);
+
+        ClockGlyphAtlas(const sf::Font& font, unsigned int characterSize);
+
+        // Cell for a character: the digit value, kColonCell or kBlankCell
+        static int getCell(char character) noexcept {
+            if (character >= '0' && character <= '9') {
+                return character - '0';
+            }
+            return character == ':' ? kColonCell : kBlankCell;
+        }
+
+        const sf::Texture& getTexture() const noexcept { return texture_; }
+        sf::Vector2f getCellSize() const noexcept { return cellSize_; }
+        sf::FloatRect getTextureRect(int cell) const noexcept { return textureRects_[cell]; }
+
+        const sf::Font& getFont() const noexcept { return *font_; }
+        unsigned int getCharacterSize() const noexcept { return characterSize_; }
+
+    private:
+        const sf::Font* font_;
+        unsigned int characterSize_;
+        sf::Texture texture_;
+        sf::Vector2f cellSize_;
+        std::array<sf::FloatRect, kCellCount> textureRects_{};
+    };
+
+} // namespace LockedAndFlow
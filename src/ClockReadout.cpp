@@ -0,0 +1,105 @@
+#include "ClockReadout.h"
+#include <algorithm>
+
+namespace LockedAndFlow {
+
+    namespace {
+
+        // Two triangles per quad, corners top-left, top-right, bottom-left, bottom-left, top-right, bottom-right
+        template <typename Point>
+        void setQuad(sf::Vertex* quad, Point topLeft, Point bottomRight, Point sf::Vertex::* member) {
+            quad[0].*member = topLeft;
+            quad[1].*member = { bottomRight.x, topLeft.y };
+            quad[2].*member = { topLeft.x, bottomRight.y };
+            quad[3].*member = { topLeft.x, bottomRight.y };
+            quad[4].*member = { bottomRight.x, topLeft.y };
+            quad[5].*member = bottomRight;
+        }
+
+    } // namespace
+
+    ClockReadout::ClockReadout(const ClockGlyphAtlas& atlas)
+        : atlas_(&atlas) {
+        cells_.fill(kNoCell);
+    }
+
+    bool ClockReadout::setText(std::string_view text) {
+        const std::size_t length = std::min(text.size(), kMaxCharacters);
+        bool changed = false;
+        if (length != length_) {
+            layOut(length);
+            changed = true;
+        }
+
+        for (std::size_t i = 0; i < length; ++i) {
+            const int cell = ClockGlyphAtlas::getCell(text[i]);
+            if (cells_[i] != cell) {
+                setCell(i, cell);
+                changed = true;
+            }
+        }
+        return changed;
+    }
+
+    void ClockReadout::setAtlas(const ClockGlyphAtlas& atlas) {
+        if (&atlas == atlas_) {
+            return;
+        }
+        atlas_ = &atlas;
+
+        const auto cells = cells_;
+        layOut(length_);
+        for (std::size_t i = 0; i < length_; ++i) {
+            setCell(i, cells[i]);
+        }
+    }
+
+    void ClockReadout::setFillColor(sf::Color color) {
+        color_ = color;
+        for (std::size_t i = 0; i < getVertexCount(); ++i) {
+            vertices_[i].color = color;
+        }
+    }
+
+    sf::FloatRect ClockReadout::getLocalBounds() const noexcept {
+        const sf::Vector2f cellSize = atlas_->getCellSize();
+        return sf::FloatRect({ 0.0f, 0.0f }, { cellSize.x * static_cast<float>(length_), cellSize.y });
+    }
+
+    sf::FloatRect ClockReadout::getGlobalBounds() const {
+        return getTransform().transformRect(getLocalBounds());
+    }
+
+    void ClockReadout::layOut(std::size_t length) {
+        length_ = length;
+        const sf::Vector2f cellSize = atlas_->getCellSize();
+        for (std::size_t i = 0; i < length; ++i) {
+            sf::Vertex* quad = &vertices_[i * 6];
+            const sf::Vector2f topLeft(cellSize.x * static_cast<float>(i), 0.0f);
+            setQuad(quad, topLeft, topLeft + cellSize, &sf::Vertex::position);
+            for (std::size_t corner = 0; corner < 6; ++corner) {
+                quad[corner].color = color_;
+            }
+            cells_[i] = kNoCell;
+        }
+    }
+
+    void ClockReadout::setCell(std::size_t index, int cell) {
+        if (cell == kNoCell) {
+            return;
+        }
+        const sf::FloatRect rect = atlas_->getTextureRect(cell);
+        setQuad(&vertices_[index * 6], rect.position, rect.position + rect.size, &sf::Vertex::texCoords);
+        cells_[index] = static_cast<std::int8_t>(cell);
+    }
+
+    void ClockReadout::draw(sf::RenderTarget& target, sf::RenderStates states) const {
+        if (length_ == 0) {
+            return;
+        }
+        states.transform *= getTransform();
+        states.texture = &atlas_->getTexture();
+        target.draw(vertices_.data(), getVertexCount(), sf::PrimitiveType::Triangles, states);
+    }
+
+} // namespace LockedAndFlow
@@ -0,0 +1,58 @@
+#pragma once
+
+#include <SFML/Graphics.hpp>
+#include "ClockGlyphAtlas.h"
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+
+namespace LockedAndFlow {
+
+    /**
+     * @brief Fixed-width clock text drawn from a ClockGlyphAtlas
+     *
+     * A drop-in for the sf::Text of a clock: each character is one quad in a
+     * fixed cell, so setText() only rewrites the texture coordinates of the
+     * quads whose character changed ("00:01:59" -> "00:02:00" touches three).
+     * There is no glyph lookup, kerning or vertex rebuild; positions are only
+     * laid out again when the length or atlas changes. Characters other than
+     * digits and ':' draw as blanks.
+     */
+    class ClockReadout : public sf::Drawable, public sf::Transformable {
+    public:
+        static constexpr std::size_t kMaxCharacters = 16;
+
+        explicit ClockReadout(const ClockGlyphAtlas& atlas);
+
+        // @return true if any character changed (the text is truncated to kMaxCharacters)
+        bool setText(std::string_view text);
+        void setAtlas(const ClockGlyphAtlas& atlas);
+        void setFillColor(sf::Color color);
+
+        const ClockGlyphAtlas& getAtlas() const noexcept { return *atlas_; }
+        sf::Color getFillColor() const noexcept { return color_; }
+        std::size_t getLength() const noexcept { return length_; }
+
+        sf::FloatRect getLocalBounds() const noexcept;
+        sf::FloatRect getGlobalBounds() const;
+
+        // Local-space triangles (6 per character) for batching with the atlas texture
+        const sf::Vertex* getVertices() const noexcept { return vertices_.data(); }
+        std::size_t getVertexCount() const noexcept { return length_ * 6; }
+
+    private:
+        static constexpr std::int8_t kNoCell = -1;
+
+        const ClockGlyphAtlas* atlas_;
+        sf::Color color_ = sf::Color::White;
+        std::size_t length_ = 0;
+        std::array<std::int8_t, kMaxCharacters> cells_;
+        std::array<sf::Vertex, kMaxCharacters * 6> vertices_;
+
+        void layOut(std::size_t length);
+        void setCell(std::size_t index, int cell);
+        void draw(sf::RenderTarget& target, sf::RenderStates states) const override;
+    };
+
+} // namespace LockedAndFlow
@@ -0,0 +1,225 @@
+#include "ControlProtocol.h"
+#include <algorithm>
+#include <charconv>
+
+namespace LockedAndFlow {
+
+    namespace {
+
+        // Pops the next space-separated word off the front of @p rest
+        std::string_view nextWord(std::string_view& rest) {
+            const auto begin = rest.find_first_not_of(' ');
+            if (begin == std::string_view::npos) {
+                rest = {};
+                return {};
+            }
+            rest.remove_prefix(begin);
+            const auto end = std::min(rest.find(' '), rest.size());
+            const auto word = rest.substr(0, end);
+            rest.remove_prefix(end);
+            return word;
+        }
+
+        const char* stateName(TimerState state) {
+            switch (state) {
+            case TimerState::Running: return "running";
+            case TimerState::Paused:  return "paused";
+            case TimerState::Stopped: return "stopped";
+            }
+            return "unknown";
+        }
+
+        void appendNumber(std::int64_t value, std::string& out) {
+            char buffer[24];
+            const auto result = std::to_chars(buffer, buffer + sizeof(buffer), value);
+            out.append(buffer, result.ptr);
+        }
+
+    } // namespace
+
+    ControlProtocol::ControlProtocol(TimerPool& pool)
+        : pool_(pool) {
+    }
+
+    std::size_t ControlProtocol::process(std::string_view input, TimePoint now, std::string& replies) {
+        std::size_t consumed = 0;
+        while (consumed < input.size()) {
+            const auto newline = input.find('\n', consumed);
+            if (newline == std::string_view::npos) {
+                break;
+            }
+            execute(input.substr(consumed, newline - consumed), now, replies);
+            consumed = newline + 1;
+        }
+        return consumed;
+    }
+
+    void ControlProtocol::execute(std::string_view line, TimePoint now, std::string& replies) {
+        if (!line.empty() && line.back() == '\r') {
+            line.remove_suffix(1); // Tolerate CRLF from interactive clients
+        }
+
+        std::string_view rest = line;
+        const auto verb = nextWord(rest);
+        if (verb.empty()) {
+            return;
+        }
+        ++requests_;
+
+        if (line.size() > kMaxLineLength) {
+            appendError("line too long", replies);
+            return;
+        }
+        if (verb == "ping") {
+            replies += "ok pong\n";
+            return;
+        }
+        if (verb == "list") {
+            replies += "ok ";
+            appendNumber(static_cast<std::int64_t>(handles_.size()), replies);
+            for (const auto& [name, handle] : handles_) {
+                replies += ' ';
+                replies += name;
+            }
+            replies += '\n';
+            return;
+        }
+
+        const auto name = nextWord(rest);
+        if (name.empty()) {
+            appendError("missing name", replies);
+            return;
+        }
+        if (name.size() > kMaxNameLength) {
+            appendError("name too long", replies);
+            return;
+        }
+
+        if (verb == "query") {
+            if (const auto* handle = find(name)) {
+                appendStatus(*handle, now, replies);
+            }
+            else {
+                appendError("no such timer", replies);
+            }
+            return;
+        }
+        if (verb == "remove") {
+            if (find(name)) {
+                remove(name);
+                replies += "ok\n";
+            }
+            else {
+                appendError("no such timer", replies);
+            }
+            return;
+        }
+
+        if (verb == "target") {
+            const auto argument = nextWord(rest);
+            std::int64_t milliseconds = 0;
+            const auto result = std::from_chars(argument.data(), argument.data() + argument.size(), milliseconds);
+            if (argument.empty() || result.ec != std::errc() || result.ptr != argument.data() + argument.size() ||
+                milliseconds < 0 || milliseconds > kMaxTargetMs) {
+                appendError("bad duration", replies);
+                return;
+            }
+
+            const auto handle = findOrCreate(name);
+            if (milliseconds == 0) {
+                pool_.clearTargetDuration(handle);
+            }
+            else {
+                pool_.setTargetDuration(handle, std::chrono::milliseconds(milliseconds));
+            }
+            appendStatus(handle, now, replies);
+            return;
+        }
+
+        TimerPool::Handle handle;
+        if (verb == "start") {
+            handle = findOrCreate(name);
+            pool_.start(handle, now);
+        }
+        else if (verb == "pause") {
+            handle = findOrCreate(name);
+            pool_.pause(handle, now);
+        }
+        else if (verb == "stop") {
+            handle = findOrCreate(name);
+            pool_.stop(handle, now);
+        }
+        else if (verb == "reset") {
+            handle = findOrCreate(name);
+            pool_.reset(handle);
+        }
+        else {
+            appendError("unknown command", replies);
+            return;
+        }
+        appendStatus(handle, now, replies);
+    }
+
+    std::string_view ControlProtocol::getName(TimerPool::Handle handle) const noexcept {
+        if (!pool_.isValid(handle) || handle.index >= names_.size()) {
+            return {};
+        }
+        return names_[handle.index];
+    }
+
+    const TimerPool::Handle* ControlProtocol::find(std::string_view name) {
+        key_.assign(name.data(), name.size());
+        const auto it = handles_.find(key_);
+        return it != handles_.end() ? &it->second : nullptr;
+    }
+
+    TimerPool::Handle ControlProtocol::findOrCreate(std::string_view name) {
+        if (const auto* handle = find(name)) {
+            return *handle;
+        }
+
+        const auto handle = pool_.create();
+        if (handle.index >= names_.size()) {
+            names_.resize(handle.index + 1);
+        }
+        names_[handle.index] = key_;
+        handles_.emplace(key_, handle);
+        return handle;
+    }
+
+    void ControlProtocol::remove(std::string_view name) {
+        key_.assign(name.data(), name.size());
+        const auto it = handles_.find(key_);
+        if (it == handles_.end()) {
+            return;
+        }
+        names_[it->second.index].clear();
+        pool_.destroy(it->second);
+        handles_.erase(it);
+    }
+
+    void ControlProtocol::appendStatus(TimerPool::Handle handle, TimePoint now, std::string& replies) const {
+        const auto elapsed = std::chrono::duration_cast<std::chrono::milliseconds>(pool_.getElapsed(handle, now));
+
+        replies += "ok ";
+        replies += stateName(pool_.getState(handle));
+        replies += ' ';
+        appendNumber(elapsed.count(), replies);
+        replies += ' ';
+        if (const auto target = pool_.getTargetDuration(handle)) {
+            appendNumber(std::chrono::duration_cast<std::chrono::milliseconds>(*target).count(), replies);
+        }
+        else {
+            replies += '-';
+        }
+        replies += '\n';
+    }
+
+    void ControlProtocol::appendError(std::string_view reason, std::string& replies) {
+        ++errors_;
+        replies += "err ";
+        replies += reason;
+        replies += '\n';
+    }
+
+} // namespace LockedAndFlow
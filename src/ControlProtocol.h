@@ -0,0 +1,81 @@
+#pragma once
+
+#include "TimerPool.h"
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+namespace LockedAndFlow {
+
+    /**
+     * @brief Line-oriented control protocol for a set of named timers
+     *
+     * Every request is one '\n'-terminated line of space-separated words and
+     * gets exactly one reply line, in request order, so a client may pipeline
+     * any number of requests in a single write. process() consumes every
+     * complete line in a buffer and appends all of the replies to one string
+     * for the transport to send with a single write. Timers live in a
+     * TimerPool, keyed by name, and are created on first use.
+     *
+     *   start|pause|stop|reset <name>   ok <state> <elapsed_ms> <target_ms|->
+     *   target <name> <ms>              (same; 0 clears the target, at most kMaxTargetMs)
+     *   query <name>                    (same; never creates the timer)
+     *   remove <name>                   ok
+     *   list                            ok <count> [<name> ...]
+     *   ping                            ok pong
+     *
+     * Failures reply "err <reason>". The protocol holds no clock of its own:
+     * callers pass `now`, and run TimerPool::updateAll() before process() so
+     * replies reflect timers that have reached their target.
+     */
+    class ControlProtocol {
+    public:
+        using TimePoint = TimerPool::TimePoint;
+
+        static constexpr std::size_t kMaxLineLength = 256;
+        static constexpr std::size_t kMaxNameLength = 64;
+        static constexpr std::int64_t kMaxTargetMs = 100LL * 366 * 24 * 60 * 60 * 1000; // Deadlines stay within the clock's range
+
+        explicit ControlProtocol(TimerPool& pool);
+
+        /**
+         * @brief Executes every complete line in @p input, appending replies to @p replies
+         *
+         * A trailing partial line is left unconsumed for the next call. If the
+         * unconsumed tail grows beyond kMaxLineLength the client is not
+         * speaking this protocol and the transport should drop it.
+         * @return Number of bytes of @p input consumed
+         */
+        std::size_t process(std::string_view input, TimePoint now, std::string& replies);
+
+        // Executes one request line (without its '\n'); empty lines produce no reply
+        void execute(std::string_view line, TimePoint now, std::string& replies);
+
+        // Name of a timer owned by this protocol; empty for unknown handles
+        std::string_view getName(TimerPool::Handle handle) const noexcept;
+
+        std::size_t getTimerCount() const noexcept { return handles_.size(); }
+        std::uint64_t getRequestCount() const noexcept { return requests_; }
+        std::uint64_t getErrorCount() const noexcept { return errors_; }
+
+    private:
+        TimerPool& pool_;
+        std::unordered_map<std::string, TimerPool::Handle> handles_;
+        std::vector<std::string> names_;   // Indexed by Handle::index
+        std::string key_;                  // Reused lookup key, avoids a per-request allocation
+
+        std::uint64_t requests_ = 0;
+        std::uint64_t errors_ = 0;
+
+        const TimerPool::Handle* find(std::string_view name);
+        TimerPool::Handle findOrCreate(std::string_view name);
+        void remove(std::string_view name);
+
+        void appendStatus(TimerPool::Handle handle, TimePoint now, std::string& replies) const;
+        void appendError(std::string_view reason, std::string& replies);
+    };
+
+} // namespace LockedAndFlow
@@ -0,0 +1,26 @@
+#include "DefaultFont.h"
+#include "EmbeddedFile.h"
+#include "Logger.h"
+
+namespace LockedAndFlow {
+
+    namespace {
+
+        sf::Font openDefaultFont() {
+            sf::Font font;
+            // The font streams glyphs from the embedded array, which lives as long as the program
+            const EmbeddedFile data = getDefaultFontData();
+            if (!font.openFromMemory(data.data, data.size)) {
+                LAF_LOG_WARN("Embedded default font ({} bytes) could not be opened", data.size);
+            }
+            return font;
+        }
+
+    } // namespace
+
+    const sf::Font& getDefaultFont() {
+        static const sf::Font font = openDefaultFont();
+        return font;
+    }
+
+} // namespace LockedAndFlow
@@ -0,0 +1,18 @@
+#pragma once
+
+#include <SFML/Graphics/Font.hpp>
+
+namespace LockedAndFlow {
+
+    /**
+     * @brief The UI font compiled into the binary (see src/EmbeddedFile.h)
+     *
+     * Opened from memory on first use, so startup does no file I/O and only
+     * pays for the font if something draws text. The build subsets it to
+     * printable ASCII when pyftsubset is available, which keeps the glyph
+     * page small. If the embedded data cannot be opened the returned font is
+     * empty and text draws nothing, as before.
+     */
+    const sf::Font& getDefaultFont();
+
+} // namespace LockedAndFlow
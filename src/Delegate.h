@@ -0,0 +1,61 @@
+#pragma once
+
+#include <cstddef>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+namespace LockedAndFlow {
+
+    template <typename Signature>
+    class Delegate;
+
+    /**
+     * @brief Non-allocating callable wrapper with inline storage
+     *
+     * Holds any trivially copyable callable of up to kInlineSize bytes (a
+     * lambda capturing a few references or pointers, a function pointer, or a
+     * bound member function) directly inside the object. Unlike std::function it
+     * never allocates and a call is a single indirect call; callables that do
+     * not fit are rejected at compile time.
+     */
+    template <typename R, typename... Args>
+    class Delegate<R(Args...)> {
+    public:
+        static constexpr std::size_t kInlineSize = 3 * sizeof(void*);
+
+        Delegate() noexcept = default;
+
+        template <typename F, typename = std::enable_if_t<!std::is_same_v<std::decay_t<F>, Delegate> &&
+            std::is_invocable_r_v<R, std::decay_t<F>&, Args...>>>
+        Delegate(F&& callable) noexcept {
+            using Callable = std::decay_t<F>;
+            static_assert(sizeof(Callable) <= kInlineSize, "Callable too large for Delegate: capture by reference");
+            static_assert(alignof(Callable) <= alignof(void*), "Callable over-aligned for Delegate");
+            static_assert(std::is_trivially_copyable_v<Callable> && std::is_trivially_destructible_v<Callable>,
+                "Delegate stores callables by bytes: capture only references, pointers and scalars");
+
+            ::new (static_cast<void*>(storage_)) Callable(std::forward<F>(callable));
+            invoke_ = [](void* storage, Args... args) -> R {
+                return (*std::launder(static_cast<Callable*>(storage)))(std::forward<Args>(args)...);
+            };
+        }
+
+        // Member function bound to an object: Delegate<...>::bind<&Type::method>(&object)
+        template <auto Method, typename T>
+        static Delegate bind(T* object) noexcept {
+            return Delegate([object](Args... args) -> R { return (object->*Method)(std::forward<Args>(args)...); });
+        }
+
+        explicit operator bool() const noexcept { return invoke_ != nullptr; }
+
+        R operator()(Args... args) const {
+            return invoke_(storage_, std::forward<Args>(args)...);
+        }
+
+    private:
+        alignas(void*) mutable unsigned char storage_[kInlineSize] = {};
+        R (*invoke_)(void*, Args...) = nullptr;
+    };
+
+} // namespace LockedAndFlow
@@ -0,0 +1,130 @@
+#include "DurationFormat.h"
+#include <cstdint>
+#include <cstring>
+
+namespace LockedAndFlow {
+
+    namespace {
+
+        constexpr char kDigitPairs[201] =
+            "00010203040506070809"
+            "10111213141516171819"
+            "20212223242526272829"
+            "30313233343536373839"
+            "40414243444546474849"
+            "50515253545556575859"
+            "60616263646566676869"
+            "70717273747576777879"
+            "80818283848586878889"
+            "90919293949596979899";
+
+        inline void writePair(char* out, unsigned value) noexcept {
+            std::memcpy(out, kDigitPairs + 2 * value, 2);
+        }
+
+        // Digits of a field that is at least two wide (hours or total minutes)
+        unsigned leadingFieldWidth(std::uint64_t value) noexcept {
+            unsigned width = 2;
+            for (std::uint64_t limit = 100; value >= limit && width < 20; limit *= 10) {
+                ++width;
+                if (limit > UINT64_MAX / 10) {
+                    break;
+                }
+            }
+            return width;
+        }
+
+        // Writes value right-aligned into exactly `width` characters
+        void writeField(char* out, unsigned width, std::uint64_t value) noexcept {
+            char* cursor = out + width;
+            while (value >= 100) {
+                cursor -= 2;
+                writePair(cursor, static_cast<unsigned>(value % 100));
+                value /= 100;
+            }
+            if (value >= 10) {
+                cursor -= 2;
+                writePair(cursor, static_cast<unsigned>(value));
+            }
+            else {
+                *--cursor = static_cast<char>('0' + value);
+            }
+            while (cursor > out) {
+                *--cursor = '0';
+            }
+        }
+
+    } // namespace
+
+    std::size_t formatDuration(char* out, std::size_t capacity, Timer::Duration duration,
+        DurationStyle style, unsigned fractionalDigits) noexcept {
+        if (fractionalDigits > 3) {
+            fractionalDigits = 3;
+        }
+
+        const std::int64_t count = duration.count();
+        const bool negative = count < 0;
+        // Magnitude without overflowing on INT64_MIN
+        const std::uint64_t milliseconds = negative
+            ? static_cast<std::uint64_t>(-(count + 1)) + 1
+            : static_cast<std::uint64_t>(count);
+
+        const std::uint64_t totalSeconds = milliseconds / 1000;
+        const unsigned millis = static_cast<unsigned>(milliseconds % 1000);
+        const unsigned seconds = static_cast<unsigned>(totalSeconds % 60);
+
+        std::uint64_t leading = 0;
+        unsigned minutes = 0;
+        const bool withHours = style == DurationStyle::HoursMinutesSeconds;
+        if (withHours) {
+            leading = totalSeconds / 3600;
+            minutes = static_cast<unsigned>((totalSeconds % 3600) / 60);
+        }
+        else {
+            leading = totalSeconds / 60;
+        }
+
+        const unsigned leadingWidth = leadingFieldWidth(leading);
+        const std::size_t length = (negative ? 1 : 0) + leadingWidth + (withHours ? 3 : 0) + 3 +
+            (fractionalDigits > 0 ? 1 + fractionalDigits : 0);
+        if (length > capacity) {
+            return 0;
+        }
+
+        char* cursor = out;
+        if (negative) {
+            *cursor++ = '-';
+        }
+
+        writeField(cursor, leadingWidth, leading);
+        cursor += leadingWidth;
+        if (withHours) {
+            *cursor++ = ':';
+            writePair(cursor, minutes);
+            cursor += 2;
+        }
+        *cursor++ = ':';
+        writePair(cursor, seconds);
+        cursor += 2;
+
+        if (fractionalDigits > 0) {
+            *cursor++ = '.';
+            char fraction[3] = { static_cast<char>('0' + millis / 100), '0', '0' };
+            writePair(fraction + 1, millis % 100);
+            std::memcpy(cursor, fraction, fractionalDigits);
+            cursor += fractionalDigits;
+        }
+
+        if (length < capacity) {
+            *cursor = '\0';
+        }
+        return length;
+    }
+
+    DurationText formatDuration(Timer::Duration duration, DurationStyle style, unsigned fractionalDigits) noexcept {
+        DurationText text;
+        text.length = formatDuration(text.data, sizeof(text.data), duration, style, fractionalDigits);
+        return text;
+    }
+
+} // namespace LockedAndFlow
@@ -0,0 +1,45 @@
+#pragma once
+
+#include "Timer.h"
+#include <cstddef>
+#include <string_view>
+
+namespace LockedAndFlow {
+
+    enum class DurationStyle {
+        HoursMinutesSeconds, // "HH:MM:SS"; hours widen past 99 ("123:04:05")
+        MinutesSeconds       // "MM:SS" with total minutes; widens past 99 ("125:07")
+    };
+
+    // Longest possible output: sign, 19-digit field, two ":NN" groups, ".mmm", NUL
+    constexpr std::size_t kMaxFormattedDurationLength = 32;
+
+    /**
+     * @brief Formats a duration into a caller-provided buffer
+     *
+     * No heap allocation, no locale, no iostreams: digits come from a two-digit
+     * lookup table. Seconds are truncated like the display always has; with
+     * @p fractionalDigits (1-3) the truncated milliseconds follow as ".d"/".dd"/".ddd".
+     * Negative durations get a leading '-'.
+     *
+     * @return Characters written, excluding the terminating NUL that is added when
+     *         it fits; 0 if @p capacity is too small for the text.
+     */
+    std::size_t formatDuration(char* out, std::size_t capacity, Timer::Duration duration,
+        DurationStyle style = DurationStyle::HoursMinutesSeconds, unsigned fractionalDigits = 0) noexcept;
+
+    /**
+     * @brief Fixed-size, stack-allocated formatted duration
+     */
+    struct DurationText {
+        char data[kMaxFormattedDurationLength] = {};
+        std::size_t length = 0;
+
+        const char* c_str() const noexcept { return data; }
+        std::string_view view() const noexcept { return std::string_view(data, length); }
+    };
+
+    DurationText formatDuration(Timer::Duration duration,
+        DurationStyle style = DurationStyle::HoursMinutesSeconds, unsigned fractionalDigits = 0) noexcept;
+
+} // namespace LockedAndFlow
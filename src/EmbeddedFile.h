@@ -0,0 +1,16 @@
+#pragma once
+
+#include <cstddef>
+
+namespace LockedAndFlow {
+
+    // A file compiled into the binary by cmake/EmbedFile.cmake; valid for the life of the program
+    struct EmbeddedFile {
+        const unsigned char* data = nullptr;
+        std::size_t size = 0;
+    };
+
+    // The default UI font (DejaVu Sans Mono, subset to printable ASCII when the build can)
+    EmbeddedFile getDefaultFontData() noexcept;
+
+} // namespace LockedAndFlow
@@ -0,0 +1,182 @@
+#include "FileIO.h"
+#include <cerrno>
+#include <cstdio>
+
+#if defined(_WIN32)
+#define WIN32_LEAN_AND_MEAN
+#define NOMINMAX
+#include <windows.h>
+#include <fcntl.h>
+#include <io.h>
+#include <share.h>
+#include <sys/stat.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace LockedAndFlow::FileIO {
+
+    int openForAppend(const std::string& path) {
+#if defined(_WIN32)
+        int fd = -1;
+        _sopen_s(&fd, path.c_str(), _O_WRONLY | _O_CREAT | _O_APPEND | _O_BINARY, _SH_DENYWR, _S_IREAD | _S_IWRITE);
+        return fd;
+#else
+        return ::open(path.c_str(), O_WRONLY | O_CREAT | O_APPEND | O_CLOEXEC, 0644);
+#endif
+    }
+
+    bool writeAll(int fd, const void* data, std::size_t size) {
+        auto bytes = static_cast<const unsigned char*>(data);
+        while (size > 0) {
+#if defined(_WIN32)
+            const int written = _write(fd, bytes, static_cast<unsigned int>(size));
+#else
+            const ssize_t written = ::write(fd, bytes, size);
+#endif
+            if (written < 0) {
+                if (errno == EINTR) {
+                    continue;
+                }
+                return false;
+            }
+            bytes += written;
+            size -= static_cast<std::size_t>(written);
+        }
+        return true;
+    }
+
+    bool syncFile(int fd) {
+#if defined(_WIN32)
+        return _commit(fd) == 0;
+#else
+        return ::fsync(fd) == 0;
+#endif
+    }
+
+    bool truncateFile(int fd, std::uint64_t size) {
+#if defined(_WIN32)
+        return _chsize_s(fd, static_cast<__int64>(size)) == 0;
+#else
+        return ::ftruncate(fd, static_cast<off_t>(size)) == 0;
+#endif
+    }
+
+    void closeFile(int fd) {
+#if defined(_WIN32)
+        _close(fd);
+#else
+        ::close(fd);
+#endif
+    }
+
+    bool replaceFile(const std::string& path, const void* data, std::size_t size) {
+        const std::string tempPath = path + ".tmp";
+        const int fd = openForAppend(tempPath);
+        if (fd < 0) {
+            return false;
+        }
+
+        const bool written = truncateFile(fd, 0) && writeAll(fd, data, size) && syncFile(fd);
+        closeFile(fd);
+        if (!written) {
+            std::remove(tempPath.c_str());
+            return false;
+        }
+
+#if defined(_WIN32)
+        return MoveFileExA(tempPath.c_str(), path.c_str(), MOVEFILE_REPLACE_EXISTING | MOVEFILE_WRITE_THROUGH) != 0;
+#else
+        return std::rename(tempPath.c_str(), path.c_str()) == 0;
+#endif
+    }
+
+    MappedFile::~MappedFile() {
+        unmap();
+    }
+
+    bool MappedFile::map(const std::string& path) {
+        // Copy first: remap() passes our own path_, which unmap() leaves intact
+        const std::string target = path;
+        unmap();
+        path_ = target;
+
+#if defined(_WIN32)
+        HANDLE file = CreateFileA(path_.c_str(), GENERIC_READ, FILE_SHARE_READ | FILE_SHARE_WRITE, nullptr,
+            OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+        if (file == INVALID_HANDLE_VALUE) {
+            return false;
+        }
+
+        LARGE_INTEGER fileSize;
+        if (!GetFileSizeEx(file, &fileSize)) {
+            CloseHandle(file);
+            return false;
+        }
+        if (fileSize.QuadPart == 0) {
+            CloseHandle(file);
+            return true; // Nothing to map yet
+        }
+
+        HANDLE mapping = CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+        CloseHandle(file);
+        if (!mapping) {
+            return false;
+        }
+
+        void* view = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+        if (!view) {
+            CloseHandle(mapping);
+            return false;
+        }
+
+        mapping_ = mapping;
+        data_ = static_cast<const unsigned char*>(view);
+        size_ = static_cast<std::size_t>(fileSize.QuadPart);
+        return true;
+#else
+        const int fd = ::open(path_.c_str(), O_RDONLY | O_CLOEXEC);
+        if (fd < 0) {
+            return false;
+        }
+
+        struct stat info;
+        if (::fstat(fd, &info) != 0) {
+            ::close(fd);
+            return false;
+        }
+        if (info.st_size == 0) {
+            ::close(fd);
+            return true; // Nothing to map yet
+        }
+
+        void* view = ::mmap(nullptr, static_cast<std::size_t>(info.st_size), PROT_READ, MAP_SHARED, fd, 0);
+        ::close(fd);
+        if (view == MAP_FAILED) {
+            return false;
+        }
+
+        data_ = static_cast<const unsigned char*>(view);
+        size_ = static_cast<std::size_t>(info.st_size);
+        return true;
+#endif
+    }
+
+    void MappedFile::unmap() {
+        if (data_) {
+#if defined(_WIN32)
+            UnmapViewOfFile(data_);
+            CloseHandle(static_cast<HANDLE>(mapping_));
+            mapping_ = nullptr;
+#else
+            ::munmap(const_cast<unsigned char*>(data_), size_);
+#endif
+        }
+        data_ = nullptr;
+        size_ = 0;
+    }
+
+} // namespace LockedAndFlow::FileIO
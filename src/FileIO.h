@@ -0,0 +1,81 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+namespace LockedAndFlow::FileIO {
+
+    // Thin wrappers over POSIX / MSVC CRT file descriptors for the persistence code.
+    // All return false (or -1 for descriptors) on failure and never throw.
+
+    int openForAppend(const std::string& path);
+    bool writeAll(int fd, const void* data, std::size_t size);
+    bool syncFile(int fd);
+    bool truncateFile(int fd, std::uint64_t size);
+    void closeFile(int fd);
+
+    // Atomically replaces @p path with @p size bytes (write to temp, fsync, rename)
+    bool replaceFile(const std::string& path, const void* data, std::size_t size);
+
+    // Little-endian encoding used by every on-disk format
+    inline void storeU32(unsigned char* out, std::uint32_t value) noexcept {
+        for (int i = 0; i < 4; ++i) {
+            out[i] = static_cast<unsigned char>(value >> (8 * i));
+        }
+    }
+
+    inline void storeI64(unsigned char* out, std::int64_t value) noexcept {
+        const auto bits = static_cast<std::uint64_t>(value);
+        for (int i = 0; i < 8; ++i) {
+            out[i] = static_cast<unsigned char>(bits >> (8 * i));
+        }
+    }
+
+    inline std::uint32_t loadU32(const unsigned char* in) noexcept {
+        std::uint32_t value = 0;
+        for (int i = 0; i < 4; ++i) {
+            value |= static_cast<std::uint32_t>(in[i]) << (8 * i);
+        }
+        return value;
+    }
+
+    inline std::int64_t loadI64(const unsigned char* in) noexcept {
+        std::uint64_t bits = 0;
+        for (int i = 0; i < 8; ++i) {
+            bits |= static_cast<std::uint64_t>(in[i]) << (8 * i);
+        }
+        return static_cast<std::int64_t>(bits);
+    }
+
+    /**
+     * @brief Read-only memory mapping of a whole file
+     *
+     * Maps nothing for empty or missing files. remap() picks up a file that
+     * has grown since it was mapped.
+     */
+    class MappedFile {
+    public:
+        MappedFile() = default;
+        ~MappedFile();
+
+        MappedFile(const MappedFile&) = delete;
+        MappedFile& operator=(const MappedFile&) = delete;
+
+        bool map(const std::string& path);
+        bool remap() { return map(path_); }
+        void unmap();
+
+        const unsigned char* data() const noexcept { return data_; }
+        std::size_t size() const noexcept { return size_; }
+
+    private:
+        std::string path_;
+        const unsigned char* data_ = nullptr;
+        std::size_t size_ = 0;
+#if defined(_WIN32)
+        void* mapping_ = nullptr;
+#endif
+    };
+
+} // namespace LockedAndFlow::FileIO
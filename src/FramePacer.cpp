@@ -0,0 +1,55 @@
+#include "FramePacer.h"
+#include <algorithm>
+
+namespace LockedAndFlow {
+
+    FramePacer::FramePacer(unsigned maxRate, unsigned minRate)
+        : maxRate_(std::max(maxRate, 1u))
+        , minRate_(std::clamp(minRate, 1u, std::max(maxRate, 1u)))
+        , rate_(maxRate_) {
+    }
+
+    FramePacer::Clock::duration FramePacer::getFrameInterval() const noexcept {
+        return std::chrono::duration_cast<Clock::duration>(std::chrono::seconds(1)) / rate_;
+    }
+
+    std::optional<FramePacer::Clock::duration> FramePacer::getTimeUntilNextFrame(Clock::time_point now) const noexcept {
+        if (!animating_) {
+            return std::nullopt;
+        }
+        if (!lastPresented_) {
+            return Clock::duration::zero();
+        }
+
+        const auto due = *lastPresented_ + getFrameInterval();
+        return due > now ? due - now : Clock::duration::zero();
+    }
+
+    void FramePacer::framePresented(Clock::time_point presentedAt, Clock::duration frameWork) noexcept {
+        lastPresented_ = presentedAt;
+        if (!animating_) {
+            return; // Input-driven frames say nothing about the paced budget
+        }
+
+        const auto budget = getFrameInterval();
+        if (frameWork * 4 > budget * 3) {
+            fastFrames_ = 0;
+            if (++slowFrames_ >= kSlowFramesToDrop && rate_ > minRate_) {
+                rate_ = std::max(rate_ / 2, minRate_);
+                slowFrames_ = 0;
+            }
+        }
+        else if (frameWork * 4 < budget) {
+            slowFrames_ = 0;
+            if (++fastFrames_ >= kFastFramesToRaise && rate_ < maxRate_) {
+                rate_ = std::min(rate_ * 2, maxRate_);
+                fastFrames_ = 0;
+            }
+        }
+        else {
+            slowFrames_ = 0;
+            fastFrames_ = 0;
+        }
+    }
+
+} // namespace LockedAndFlow
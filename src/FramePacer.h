@@ -0,0 +1,49 @@
+#pragma once
+
+#include <chrono>
+#include <optional>
+
+namespace LockedAndFlow {
+
+    /**
+     * @brief Chooses when the next frame should be drawn
+     *
+     * While something animates (a moving progress bar) frames are paced at the
+     * active rate; otherwise the pacer asks for no frames at all and the loop
+     * waits for input or the next visible tick. The active rate adapts to the
+     * measured frame cost: it halves (down to the minimum rate) after a run of
+     * frames that use most of their budget, and doubles back once frames have
+     * stayed cheap for a while.
+     */
+    class FramePacer {
+    public:
+        using Clock = std::chrono::steady_clock;
+
+        explicit FramePacer(unsigned maxRate = 60, unsigned minRate = 15);
+
+        void setAnimating(bool animating) noexcept { animating_ = animating; }
+        bool isAnimating() const noexcept { return animating_; }
+
+        // Time until the next paced frame is due; empty when nothing animates
+        std::optional<Clock::duration> getTimeUntilNextFrame(Clock::time_point now) const noexcept;
+
+        // Report a presented frame and the work it took (excluding time spent waiting)
+        void framePresented(Clock::time_point presentedAt, Clock::duration frameWork) noexcept;
+
+        unsigned getTargetRate() const noexcept { return rate_; }
+        Clock::duration getFrameInterval() const noexcept;
+
+    private:
+        static constexpr unsigned kSlowFramesToDrop = 8;    // Consecutive frames over budget
+        static constexpr unsigned kFastFramesToRaise = 120; // Consecutive frames well under budget
+
+        unsigned maxRate_;
+        unsigned minRate_;
+        unsigned rate_;
+        bool animating_ = false;
+        std::optional<Clock::time_point> lastPresented_;
+        unsigned slowFrames_ = 0;
+        unsigned fastFrames_ = 0;
+    };
+
+} // namespace LockedAndFlow
@@ -0,0 +1,130 @@
+#include "FrameProfiler.h"
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <ostream>
+
+namespace LockedAndFlow {
+
+    namespace {
+
+        double toMilliseconds(std::chrono::microseconds value) {
+            return static_cast<double>(value.count()) / 1000.0;
+        }
+
+    } // namespace
+
+    const char* toString(FramePhase phase) noexcept {
+        switch (phase) {
+        case FramePhase::Events:  return "events";
+        case FramePhase::Update:  return "update";
+        case FramePhase::Display: return "display";
+        case FramePhase::Draw:    return "draw";
+        case FramePhase::Present: return "present";
+        default: return "unknown";
+        }
+    }
+
+    void FrameProfiler::Histogram::record(std::chrono::microseconds sample) noexcept {
+        const auto bucket = static_cast<std::size_t>(std::max<std::int64_t>(sample / kBucketWidth, 0));
+        ++buckets[std::min(bucket, kBucketCount - 1)];
+        ++count;
+        max = std::max(max, sample);
+    }
+
+    std::chrono::microseconds FrameProfiler::Histogram::percentile(double fraction) const noexcept {
+        if (count == 0) {
+            return std::chrono::microseconds::zero();
+        }
+
+        // Upper edge of the bucket holding the requested rank, capped by the exact maximum
+        const auto rank = static_cast<std::uint64_t>(
+            std::ceil(std::clamp(fraction, 0.0, 1.0) * static_cast<double>(count)));
+        std::uint64_t seen = 0;
+        for (std::size_t i = 0; i < kBucketCount; ++i) {
+            seen += buckets[i];
+            if (seen >= std::max<std::uint64_t>(rank, 1)) {
+                return std::min(kBucketWidth * static_cast<std::int64_t>(i + 1), max);
+            }
+        }
+        return max;
+    }
+
+    void FrameProfiler::beginFrame(Clock::time_point now) noexcept {
+        frameStart_ = now;
+        lastMark_ = now;
+    }
+
+    void FrameProfiler::endPhase(FramePhase phase, Clock::time_point now) noexcept {
+        phases_[static_cast<std::size_t>(phase)].record(
+            std::chrono::duration_cast<std::chrono::microseconds>(now - lastMark_));
+        lastMark_ = now;
+    }
+
+    void FrameProfiler::endFrame(Clock::time_point now) noexcept {
+        lastFrameTime_ = std::chrono::duration_cast<std::chrono::microseconds>(now - frameStart_);
+        frames_.record(lastFrameTime_);
+    }
+
+    void FrameProfiler::clear() noexcept {
+        phases_ = {};
+        frames_ = {};
+        lastFrameTime_ = std::chrono::microseconds::zero();
+    }
+
+    std::chrono::microseconds FrameProfiler::getPercentile(double fraction) const noexcept {
+        return frames_.percentile(fraction);
+    }
+
+    std::uint64_t FrameProfiler::getSampleCount(FramePhase phase) const noexcept {
+        return phases_[static_cast<std::size_t>(phase)].count;
+    }
+
+    std::chrono::microseconds FrameProfiler::getPercentile(FramePhase phase, double fraction) const noexcept {
+        return phases_[static_cast<std::size_t>(phase)].percentile(fraction);
+    }
+
+    std::chrono::microseconds FrameProfiler::getMax(FramePhase phase) const noexcept {
+        return phases_[static_cast<std::size_t>(phase)].max;
+    }
+
+    std::string FrameProfiler::getSummary() const {
+        char line[128];
+        std::snprintf(line, sizeof(line), "frame p50 %.1f ms  p99 %.1f ms  (%llu frames)",
+            toMilliseconds(getPercentile(0.5)), toMilliseconds(getPercentile(0.99)),
+            static_cast<unsigned long long>(getFrameCount()));
+
+        std::string summary = line;
+        for (std::size_t i = 0; i < phases_.size(); ++i) {
+            const auto phase = static_cast<FramePhase>(i);
+            std::snprintf(line, sizeof(line), "\n%-8s p50 %.2f ms  p99 %.2f ms", toString(phase),
+                toMilliseconds(getPercentile(phase, 0.5)), toMilliseconds(getPercentile(phase, 0.99)));
+            summary += line;
+        }
+        return summary;
+    }
+
+    void FrameProfiler::writeReport(std::ostream& out) const {
+        char line[128];
+        std::snprintf(line, sizeof(line), "Frame timing: %llu frames (0.1 ms buckets)\n",
+            static_cast<unsigned long long>(getFrameCount()));
+        out << line;
+        std::snprintf(line, sizeof(line), "  %-8s %10s %9s %9s %9s\n", "phase", "samples", "p50 ms", "p99 ms", "max ms");
+        out << line;
+
+        for (std::size_t i = 0; i < phases_.size(); ++i) {
+            const auto phase = static_cast<FramePhase>(i);
+            std::snprintf(line, sizeof(line), "  %-8s %10llu %9.2f %9.2f %9.2f\n", toString(phase),
+                static_cast<unsigned long long>(getSampleCount(phase)),
+                toMilliseconds(getPercentile(phase, 0.5)), toMilliseconds(getPercentile(phase, 0.99)),
+                toMilliseconds(getMax(phase)));
+            out << line;
+        }
+
+        std::snprintf(line, sizeof(line), "  %-8s %10llu %9.2f %9.2f %9.2f\n", "frame",
+            static_cast<unsigned long long>(getFrameCount()),
+            toMilliseconds(getPercentile(0.5)), toMilliseconds(getPercentile(0.99)), toMilliseconds(getMax()));
+        out << line;
+    }
+
+} // namespace LockedAndFlow
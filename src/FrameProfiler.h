@@ -0,0 +1,78 @@
+#pragma once
+
+#include <array>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <iosfwd>
+#include <string>
+
+namespace LockedAndFlow {
+
+    enum class FramePhase : std::size_t {
+        Events,     // Waking up and handling input
+        Update,     // Timer::update() and persistence
+        Display,    // TimerDisplay::updateFromTimer()
+        Draw,       // clear() and draw calls
+        Present,    // display()
+        Count
+    };
+
+    const char* toString(FramePhase phase) noexcept;
+
+    /**
+     * @brief Per-phase frame timing with fixed-bucket histograms
+     *
+     * The caller brackets a frame with beginFrame()/endFrame() and calls
+     * endPhase() as each phase finishes; a phase lasts from the previous mark.
+     * Samples go into 0.1 ms buckets (the last one collects everything slower),
+     * so recording never allocates and percentiles cost one pass over the
+     * buckets. Frames that are started but never ended (nothing to draw) still
+     * contribute the phases they ran, but not a total frame time.
+     */
+    class FrameProfiler {
+    public:
+        using Clock = std::chrono::steady_clock;
+
+        static constexpr std::chrono::microseconds kBucketWidth{ 100 };
+        static constexpr std::size_t kBucketCount = 1000;
+
+        // Recording
+        void beginFrame(Clock::time_point now) noexcept;
+        void endPhase(FramePhase phase, Clock::time_point now) noexcept;
+        void endFrame(Clock::time_point now) noexcept;
+        void clear() noexcept;
+
+        // Whole-frame statistics
+        std::uint64_t getFrameCount() const noexcept { return frames_.count; }
+        std::chrono::microseconds getLastFrameTime() const noexcept { return lastFrameTime_; }
+        std::chrono::microseconds getPercentile(double fraction) const noexcept;
+        std::chrono::microseconds getMax() const noexcept { return frames_.max; }
+
+        // Per-phase statistics
+        std::uint64_t getSampleCount(FramePhase phase) const noexcept;
+        std::chrono::microseconds getPercentile(FramePhase phase, double fraction) const noexcept;
+        std::chrono::microseconds getMax(FramePhase phase) const noexcept;
+
+        // One-line p50/p99 summary for an overlay, and a full table for a report
+        std::string getSummary() const;
+        void writeReport(std::ostream& out) const;
+
+    private:
+        struct Histogram {
+            std::array<std::uint32_t, kBucketCount> buckets{};
+            std::uint64_t count = 0;
+            std::chrono::microseconds max{ 0 };
+
+            void record(std::chrono::microseconds sample) noexcept;
+            std::chrono::microseconds percentile(double fraction) const noexcept;
+        };
+
+        std::array<Histogram, static_cast<std::size_t>(FramePhase::Count)> phases_;
+        Histogram frames_;
+        Clock::time_point frameStart_;
+        Clock::time_point lastMark_;
+        std::chrono::microseconds lastFrameTime_{ 0 };
+    };
+
+} // namespace LockedAndFlow
@@ -0,0 +1,62 @@
+#include "LayerCache.h"
+#include <utility>
+
+namespace LockedAndFlow {
+
+    namespace {
+
+        // The cache holds premultiplied colour (translucent draws onto a transparent clear)
+        const sf::BlendMode kPremultipliedAlpha(sf::BlendMode::Factor::One, sf::BlendMode::Factor::OneMinusSrcAlpha);
+
+        bool sameView(const sf::View& a, const sf::View& b) {
+            return a.getCenter() == b.getCenter() && a.getSize() == b.getSize() &&
+                a.getRotation() == b.getRotation() && a.getViewport() == b.getViewport();
+        }
+
+    } // namespace
+
+    LayerCache::LayerCache(std::string name)
+        : name_(std::move(name)) {
+    }
+
+    bool LayerCache::prepare(const sf::RenderTarget& target) {
+        const sf::Vector2u size = target.getSize();
+        if (failed_ || size.x == 0 || size.y == 0) {
+            return false;
+        }
+
+        if (texture_.getSize() != size) {
+            if (!texture_.resize(size)) {
+                failed_ = true;
+                return false;
+            }
+            valid_ = false;
+        }
+        if (!sameView(target.getView(), paintedView_)) {
+            valid_ = false;
+        }
+
+        if (!valid_) {
+            paintedView_ = target.getView();
+            texture_.setView(paintedView_);
+            texture_.clear(sf::Color::Transparent);
+        }
+        return true;
+    }
+
+    void LayerCache::finishRepaint() {
+        texture_.display();
+        valid_ = true;
+        ++redraws_;
+    }
+
+    void LayerCache::composite(sf::RenderTarget& target) {
+        // One textured quad in pixel space, whatever view the target uses
+        const sf::View view = target.getView();
+        target.setView(sf::View(sf::FloatRect({ 0.0f, 0.0f }, sf::Vector2f(texture_.getSize()))));
+        target.draw(sf::Sprite(texture_.getTexture()), kPremultipliedAlpha);
+        target.setView(view);
+        ++composites_;
+    }
+
+} // namespace LockedAndFlow
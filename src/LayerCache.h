@@ -0,0 +1,69 @@
+#pragma once
+
+#include <SFML/Graphics.hpp>
+#include <cstdint>
+#include <string>
+
+namespace LockedAndFlow {
+
+    /**
+     * @brief Caches drawables that rarely change in an sf::RenderTexture
+     *
+     * draw() repaints the cache only when it has been invalidated, the target
+     * has been resized or the target's view has changed; otherwise it
+     * composites the cached pixels onto the target with a single sprite draw.
+     * The owner calls invalidate() whenever something in the layer moves or
+     * restyles (setPosition, setFont, setCharacterSize...).
+     *
+     * The cache covers the whole target at its pixel size and is painted
+     * through the target's view, so it looks the same as drawing directly. It
+     * is cleared to transparent and composited with premultiplied alpha, so
+     * translucent shapes and antialiased text blend as if drawn directly. If
+     * the render texture cannot be created, every draw() paints straight to
+     * the target.
+     */
+    class LayerCache {
+    public:
+        explicit LayerCache(std::string name);
+
+        void invalidate() noexcept { valid_ = false; }
+        bool isValid() const noexcept { return valid_; }
+
+        /**
+         * @brief Draws the layer onto @p target, calling @p paint(sf::RenderTarget&) only to repaint it
+         */
+        template <typename Paint>
+        void draw(sf::RenderTarget& target, Paint&& paint) {
+            if (!prepare(target)) {
+                paint(target); // No render texture: uncached
+                ++redraws_;
+                return;
+            }
+            if (!valid_) {
+                paint(texture_);
+                finishRepaint();
+            }
+            composite(target);
+        }
+
+        const std::string& getName() const noexcept { return name_; }
+        std::uint64_t getRedrawCount() const noexcept { return redraws_; }
+        std::uint64_t getCompositeCount() const noexcept { return composites_; }
+
+    private:
+        std::string name_;
+        sf::RenderTexture texture_;
+        bool valid_ = false;
+        bool failed_ = false;
+        sf::View paintedView_;
+        std::uint64_t redraws_ = 0;
+        std::uint64_t composites_ = 0;
+
+        // Sizes the texture to @p target and readies it for a repaint if needed.
+        // @return false if there is no usable render texture
+        bool prepare(const sf::RenderTarget& target);
+        void finishRepaint();
+        void composite(sf::RenderTarget& target);
+    };
+
+} // namespace LockedAndFlow
@@ -0,0 +1,184 @@
+#include "Logger.h"
+#include "DurationFormat.h"
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+#include <iostream>
+
+namespace LockedAndFlow {
+
+    const char* toString(LogLevel level) noexcept {
+        switch (level) {
+        case LogLevel::Trace: return "TRACE";
+        case LogLevel::Debug: return "DEBUG";
+        case LogLevel::Info:  return "INFO";
+        case LogLevel::Warn:  return "WARN";
+        case LogLevel::Error: return "ERROR";
+        }
+        return "?";
+    }
+
+    void LogRecord::add(std::string_view value) noexcept {
+        const auto length = std::min(value.size(), kTextCapacity - textLength);
+        std::memcpy(text + textLength, value.data(), length);
+
+        auto& span = push(ArgumentType::Text).span;
+        span.offset = textLength;
+        span.length = static_cast<std::uint8_t>(length);
+        textLength = static_cast<std::uint8_t>(textLength + length);
+    }
+
+    void LogRecord::formatMessage(std::string& out) const {
+        std::size_t argument = 0;
+        for (const char* cursor = format; *cursor; ++cursor) {
+            if (cursor[0] != '{' || cursor[1] != '}' || argument >= argumentCount) {
+                out += *cursor;
+                continue;
+            }
+            ++cursor;
+
+            const Value& value = values[argument];
+            char number[32];
+            switch (types[argument++]) {
+            case ArgumentType::Signed:
+                out.append(number, static_cast<std::size_t>(std::snprintf(number, sizeof(number), "%lld",
+                    static_cast<long long>(value.i))));
+                break;
+            case ArgumentType::Unsigned:
+                out.append(number, static_cast<std::size_t>(std::snprintf(number, sizeof(number), "%llu",
+                    static_cast<unsigned long long>(value.u))));
+                break;
+            case ArgumentType::Float:
+                out.append(number, static_cast<std::size_t>(std::snprintf(number, sizeof(number), "%.6g", value.f)));
+                break;
+            case ArgumentType::Bool:
+                out += value.u ? "true" : "false";
+                break;
+            case ArgumentType::Text:
+                out.append(text + value.span.offset, value.span.length);
+                break;
+            case ArgumentType::Duration:
+                out += formatDuration(std::chrono::milliseconds(value.i)).view();
+                break;
+            }
+        }
+    }
+
+    Logger::Logger(std::ostream& out)
+        : out_(out)
+        , startTime_(LogRecord::Clock::now())
+        , writer_([this] { run(); }) {
+    }
+
+    Logger::~Logger() {
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            stopping_ = true;
+        }
+        wake_.notify_one();
+        writer_.join();
+    }
+
+    void Logger::flush() {
+        std::unique_lock<std::mutex> lock(mutex_);
+        const auto request = ++flushRequests_;
+        wake_.notify_one();
+        flushed_.wait(lock, [&] { return flushesDone_ >= request; });
+    }
+
+    bool Logger::push(const LogRecord& record) noexcept {
+        if (ring_.tryPush(record)) {
+            // Pairs with the fence in run(): either the writer sees this record before
+            // sleeping or this sees writerIdle_ set
+            std::atomic_thread_fence(std::memory_order_seq_cst);
+            if (writerIdle_.load(std::memory_order_relaxed) && writerIdle_.exchange(false)) {
+                // Empty to non-empty: the one wake per batch that must not be missed
+                std::lock_guard<std::mutex> lock(mutex_);
+                wake_.notify_one();
+            }
+            else if (ring_.sizeApprox() == kCapacity / 2) {
+                // A burst: write early rather than drop. notify_one() without the mutex never
+                // blocks, and a wake it misses only delays the batch to its flush deadline
+                wake_.notify_one();
+            }
+            return true;
+        }
+        dropped_.fetch_add(1, std::memory_order_relaxed);
+        return false;
+    }
+
+    bool Logger::writeBatch() {
+        batch_.clear();
+        std::size_t drained = 0;
+        LogRecord record;
+        while (drained < kCapacity && ring_.tryPop(record)) {
+            const auto sinceStart = std::chrono::duration_cast<std::chrono::milliseconds>(record.time - startTime_).count();
+            char prefix[48];
+            const int prefixLength = std::snprintf(prefix, sizeof(prefix), "[%6lld.%03lld] %-5s ",
+                static_cast<long long>(sinceStart / 1000), static_cast<long long>(sinceStart % 1000),
+                toString(record.level));
+            batch_.append(prefix, static_cast<std::size_t>(std::max(prefixLength, 0)));
+            record.formatMessage(batch_);
+            batch_ += '\n';
+            ++drained;
+        }
+
+        const auto dropped = dropped_.load(std::memory_order_relaxed);
+        if (dropped != droppedReported_) {
+            batch_ += "[logger] " + std::to_string(dropped - droppedReported_) + " messages dropped\n";
+            droppedReported_ = dropped;
+        }
+
+        if (!batch_.empty()) {
+            out_.write(batch_.data(), static_cast<std::streamsize>(batch_.size()));
+            out_.flush();
+            written_.fetch_add(drained, std::memory_order_relaxed);
+        }
+        return drained > 0;
+    }
+
+    void Logger::run() {
+        std::unique_lock<std::mutex> lock(mutex_);
+        for (;;) {
+            const auto requests = flushRequests_;
+            const bool stopping = stopping_;
+
+            // Write without the lock so flush() callers only wait for the drain itself
+            lock.unlock();
+            while (writeBatch()) {
+            }
+            lock.lock();
+
+            if (flushesDone_ != requests) {
+                flushesDone_ = requests;
+                flushed_.notify_all();
+            }
+            if (stopping) {
+                return;
+            }
+
+            const auto requested = [this] { return stopping_ || flushRequests_ != flushesDone_; };
+            if (requested()) {
+                continue;
+            }
+
+            // Idle: block until a producer reports the first record, with no timeout
+            writerIdle_.store(true, std::memory_order_relaxed);
+            std::atomic_thread_fence(std::memory_order_seq_cst);
+            if (ring_.sizeApprox() == 0) {
+                wake_.wait(lock, [&] { return requested() || !writerIdle_.load(std::memory_order_relaxed); });
+            }
+            writerIdle_.store(false, std::memory_order_relaxed);
+
+            // Records are queued: let the rest of the burst join them until the flush deadline
+            wake_.wait_until(lock, LogRecord::Clock::now() + kFlushInterval,
+                [&] { return requested() || ring_.sizeApprox() >= kCapacity / 2; });
+        }
+    }
+
+    Logger& defaultLogger() {
+        static Logger logger(std::cout);
+        return logger;
+    }
+
+} // namespace LockedAndFlow
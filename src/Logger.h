@@ -0,0 +1,216 @@
+#pragma once
+
+#include "MpscRing.h"
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <ostream>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <type_traits>
+
+// Compile-time log levels: calls below LAF_LOG_LEVEL expand to nothing and
+// their arguments are never evaluated. CMake sets it from LOCKEDANDFLOW_LOG_LEVEL
+#define LAF_LOG_LEVEL_TRACE 0
+#define LAF_LOG_LEVEL_DEBUG 1
+#define LAF_LOG_LEVEL_INFO  2
+#define LAF_LOG_LEVEL_WARN  3
+#define LAF_LOG_LEVEL_ERROR 4
+#define LAF_LOG_LEVEL_OFF   5
+
+#ifndef LAF_LOG_LEVEL
+#define LAF_LOG_LEVEL LAF_LOG_LEVEL_INFO
+#endif
+
+#define LAF_LOG_AT(level, ...) ::LockedAndFlow::defaultLogger().log(::LockedAndFlow::LogLevel::level, __VA_ARGS__)
+
+#if LAF_LOG_LEVEL <= LAF_LOG_LEVEL_TRACE
+#define LAF_LOG_TRACE(...) LAF_LOG_AT(Trace, __VA_ARGS__)
+#else
+#define LAF_LOG_TRACE(...) ((void)0)
+#endif
+
+#if LAF_LOG_LEVEL <= LAF_LOG_LEVEL_DEBUG
+#define LAF_LOG_DEBUG(...) LAF_LOG_AT(Debug, __VA_ARGS__)
+#else
+#define LAF_LOG_DEBUG(...) ((void)0)
+#endif
+
+#if LAF_LOG_LEVEL <= LAF_LOG_LEVEL_INFO
+#define LAF_LOG_INFO(...) LAF_LOG_AT(Info, __VA_ARGS__)
+#else
+#define LAF_LOG_INFO(...) ((void)0)
+#endif
+
+#if LAF_LOG_LEVEL <= LAF_LOG_LEVEL_WARN
+#define LAF_LOG_WARN(...) LAF_LOG_AT(Warn, __VA_ARGS__)
+#else
+#define LAF_LOG_WARN(...) ((void)0)
+#endif
+
+#if LAF_LOG_LEVEL <= LAF_LOG_LEVEL_ERROR
+#define LAF_LOG_ERROR(...) LAF_LOG_AT(Error, __VA_ARGS__)
+#else
+#define LAF_LOG_ERROR(...) ((void)0)
+#endif
+
+namespace LockedAndFlow {
+
+    enum class LogLevel : std::uint8_t {
+        Trace,
+        Debug,
+        Info,
+        Warn,
+        Error
+    };
+
+    const char* toString(LogLevel level) noexcept;
+
+    /**
+     * @brief One log call, captured unformatted
+     *
+     * Holds the format string (which must be a string literal: only its pointer
+     * is stored), a timestamp and up to kMaxArguments typed arguments. Text
+     * arguments are copied into a small inline buffer and truncated when it is
+     * full. Formatting, including durations, happens on the logger thread.
+     */
+    struct LogRecord {
+        using Clock = std::chrono::steady_clock;
+
+        static constexpr std::size_t kMaxArguments = 4;
+        static constexpr std::size_t kTextCapacity = 64;
+
+        enum class ArgumentType : std::uint8_t {
+            Signed,
+            Unsigned,
+            Float,
+            Bool,
+            Text,       // Span into text
+            Duration    // Milliseconds, printed as HH:MM:SS
+        };
+
+        Clock::time_point time;
+        const char* format = "";
+        LogLevel level = LogLevel::Info;
+        std::uint8_t argumentCount = 0;
+        std::uint8_t textLength = 0;
+        ArgumentType types[kMaxArguments]{};
+        union Value {
+            std::int64_t i;
+            std::uint64_t u;
+            double f;
+            struct { std::uint8_t offset, length; } span;
+        } values[kMaxArguments]{};
+        char text[kTextCapacity];
+
+        void add(bool value) noexcept { push(ArgumentType::Bool).u = value; }
+        void add(std::string_view value) noexcept;
+        void add(const char* value) noexcept { add(std::string_view(value ? value : "(null)")); }
+        void add(const std::string& value) noexcept { add(std::string_view(value)); }
+        void add(std::chrono::milliseconds value) noexcept { push(ArgumentType::Duration).i = value.count(); }
+
+        template <typename T, std::enable_if_t<std::is_integral_v<T> && !std::is_same_v<T, bool>, int> = 0>
+        void add(T value) noexcept {
+            if constexpr (std::is_signed_v<T>) {
+                push(ArgumentType::Signed).i = value;
+            }
+            else {
+                push(ArgumentType::Unsigned).u = value;
+            }
+        }
+
+        template <typename T, std::enable_if_t<std::is_floating_point_v<T>, int> = 0>
+        void add(T value) noexcept { push(ArgumentType::Float).f = static_cast<double>(value); }
+
+        // Appends "<format with each {} replaced by the next argument>" to @p out
+        void formatMessage(std::string& out) const;
+
+    private:
+        Value& push(ArgumentType type) noexcept {
+            types[argumentCount] = type;
+            return values[argumentCount++];
+        }
+    };
+
+    /**
+     * @brief Asynchronous logger: producers enqueue records, one thread writes them
+     *
+     * log() captures its arguments into a fixed-size LogRecord and pushes it
+     * into a lock-free MpscRing: no formatting, no lock, no syscall and no
+     * allocation on the calling thread in the common case, so the render loop
+     * never waits on a terminal. A background thread drains the ring, formats the records and
+     * writes each batch to the stream with a single write and flush. An idle
+     * writer sleeps until a record arrives, then lets records gather for up to
+     * kFlushInterval before writing. When the ring is full the record is
+     * dropped and counted instead of blocking; the writer reports drops in the
+     * output.
+     */
+    class Logger {
+    public:
+        static constexpr std::size_t kCapacity = 1024;
+        static constexpr std::chrono::milliseconds kFlushInterval{ 50 };
+
+        explicit Logger(std::ostream& out);
+        ~Logger(); // Writes everything still queued
+
+        Logger(const Logger&) = delete;
+        Logger& operator=(const Logger&) = delete;
+
+        /**
+         * @brief Queues one message; "{}" in @p format is replaced by the next argument
+         * @return false if the ring was full and the message was dropped
+         */
+        template <typename... Args>
+        bool log(LogLevel level, const char* format, const Args&... args) noexcept {
+            static_assert(sizeof...(Args) <= LogRecord::kMaxArguments, "Too many log arguments");
+
+            LogRecord record;
+            record.time = LogRecord::Clock::now();
+            record.level = level;
+            record.format = format;
+            (record.add(args), ...);
+            return push(record);
+        }
+
+        // Blocks until everything queued before the call has been written
+        void flush();
+
+        std::uint64_t getDroppedCount() const noexcept { return dropped_.load(std::memory_order_relaxed); }
+        std::uint64_t getWrittenCount() const noexcept { return written_.load(std::memory_order_relaxed); }
+
+    private:
+        std::ostream& out_;
+        const LogRecord::Clock::time_point startTime_;
+        MpscRing<LogRecord, kCapacity> ring_;
+
+        std::atomic<std::uint64_t> dropped_{ 0 };
+        std::atomic<std::uint64_t> written_{ 0 };
+        std::uint64_t droppedReported_ = 0;     // Writer thread only
+
+        // Writer wake-ups. Producers notify wake_ only for the first record after the
+        // writer went idle (taking the mutex, so the wake cannot be lost) and when the
+        // ring is half full.
+        std::atomic<bool> writerIdle_{ false };
+        std::mutex mutex_;
+        std::condition_variable wake_;
+        std::condition_variable flushed_;
+        std::uint64_t flushRequests_ = 0;
+        std::uint64_t flushesDone_ = 0;
+        bool stopping_ = false;
+
+        std::string batch_;
+        std::thread writer_;
+
+        bool push(const LogRecord& record) noexcept;
+        bool writeBatch();
+        void run();
+    };
+
+    // Process-wide logger writing to std::cout, used by the LAF_LOG_* macros
+    Logger& defaultLogger();
+
+} // namespace LockedAndFlow
@@ -0,0 +1,101 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+
+namespace LockedAndFlow {
+
+    /**
+     * @brief Bounded lock-free multi-producer / single-consumer ring
+     *
+     * Dmitry Vyukov's bounded queue: every cell carries a sequence number that
+     * tells producers when it is free and the consumer when it is filled, so a
+     * push is one CAS on the tail plus two stores and a pop is two loads and a
+     * store, with no mutex anywhere. Producers never wait on each other beyond
+     * a CAS retry and never block on the consumer: tryPush() fails when full.
+     * Only one thread may call tryPop().
+     *
+     * @tparam T Trivially copyable payload
+     * @tparam Capacity Number of cells; a power of two
+     */
+    template <typename T, std::size_t Capacity>
+    class MpscRing {
+        static_assert(Capacity >= 2 && (Capacity & (Capacity - 1)) == 0, "Capacity must be a power of two");
+        static_assert(std::is_trivially_copyable_v<T>, "MpscRing payloads are copied between threads");
+
+    public:
+        static constexpr std::size_t kCapacity = Capacity;
+
+        MpscRing() noexcept {
+            for (std::size_t i = 0; i < Capacity; ++i) {
+                cells_[i].sequence.store(i, std::memory_order_relaxed);
+            }
+        }
+
+        MpscRing(const MpscRing&) = delete;
+        MpscRing& operator=(const MpscRing&) = delete;
+
+        // Any thread. @return false if the ring is full
+        bool tryPush(const T& value) noexcept {
+            std::size_t position = tail_.load(std::memory_order_relaxed);
+            for (;;) {
+                Cell& cell = cells_[position & kMask];
+                const std::size_t sequence = cell.sequence.load(std::memory_order_acquire);
+                const auto difference = static_cast<std::intptr_t>(sequence) - static_cast<std::intptr_t>(position);
+                if (difference == 0) {
+                    if (tail_.compare_exchange_weak(position, position + 1, std::memory_order_relaxed)) {
+                        cell.value = value;
+                        cell.sequence.store(position + 1, std::memory_order_release);
+                        return true;
+                    }
+                }
+                else if (difference < 0) {
+                    return false; // The consumer has not freed this cell yet: full
+                }
+                else {
+                    position = tail_.load(std::memory_order_relaxed); // Another producer won the cell
+                }
+            }
+        }
+
+        // Consumer thread only. @return false if the ring is empty
+        bool tryPop(T& value) noexcept {
+            const std::size_t head = head_.load(std::memory_order_relaxed);
+            Cell& cell = cells_[head & kMask];
+            const std::size_t sequence = cell.sequence.load(std::memory_order_acquire);
+            if (sequence != head + 1) {
+                return false; // Empty, or the producer that claimed it has not finished writing
+            }
+
+            value = cell.value;
+            cell.sequence.store(head + Capacity, std::memory_order_release);
+            head_.store(head + 1, std::memory_order_relaxed);
+            return true;
+        }
+
+        // Exact only when no thread is pushing or popping
+        std::size_t sizeApprox() const noexcept {
+            const std::size_t head = head_.load(std::memory_order_relaxed);
+            const std::size_t tail = tail_.load(std::memory_order_relaxed);
+            return tail > head ? tail - head : 0;
+        }
+
+    private:
+        static constexpr std::size_t kMask = Capacity - 1;
+        static constexpr std::size_t kCacheLine = 64;
+
+        struct alignas(kCacheLine) Cell {
+            std::atomic<std::size_t> sequence;
+            T value;
+        };
+
+        // Producers and the consumer write different lines
+        alignas(kCacheLine) std::array<Cell, Capacity> cells_;
+        alignas(kCacheLine) std::atomic<std::size_t> tail_{ 0 };
+        alignas(kCacheLine) std::atomic<std::size_t> head_{ 0 }; // Written by the consumer only
+    };
+
+} // namespace LockedAndFlow
@@ -0,0 +1,273 @@
+#include "RollupTable.h"
+#include "FileIO.h"
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+#include <ctime>
+
+namespace LockedAndFlow {
+
+    using namespace FileIO;
+
+    namespace {
+
+        constexpr unsigned char kMagic[8] = { 'L', 'A', 'F', 'R', 'O', 'L', 'L', '\0' };
+        constexpr std::uint32_t kFormatVersion = 1;
+        constexpr std::size_t kHeaderSize = 32;
+        constexpr std::int64_t kMsPerDay = 24LL * 60 * 60 * 1000;
+
+        std::int64_t floorDiv(std::int64_t value, std::int64_t divisor) noexcept {
+            const std::int64_t quotient = value / divisor;
+            return (value % divisor != 0 && (value < 0) != (divisor < 0)) ? quotient - 1 : quotient;
+        }
+
+        // Proleptic Gregorian calendar conversions (days since 1970-01-01)
+        std::int64_t daysFromCivil(std::int64_t year, unsigned month, unsigned day) noexcept {
+            year -= month <= 2;
+            const std::int64_t era = floorDiv(year, 400);
+            const auto yearOfEra = static_cast<unsigned>(year - era * 400);
+            const unsigned dayOfYear = (153 * (month > 2 ? month - 3 : month + 9) + 2) / 5 + day - 1;
+            const unsigned dayOfEra = yearOfEra * 365 + yearOfEra / 4 - yearOfEra / 100 + dayOfYear;
+            return era * 146097 + static_cast<std::int64_t>(dayOfEra) - 719468;
+        }
+
+        void civilFromDays(std::int64_t days, std::int64_t& year, unsigned& month) noexcept {
+            days += 719468;
+            const std::int64_t era = floorDiv(days, 146097);
+            const auto dayOfEra = static_cast<unsigned>(days - era * 146097);
+            const unsigned yearOfEra = (dayOfEra - dayOfEra / 1460 + dayOfEra / 36524 - dayOfEra / 146096) / 365;
+            const unsigned dayOfYear = dayOfEra - (365 * yearOfEra + yearOfEra / 4 - yearOfEra / 100);
+            const unsigned shiftedMonth = (5 * dayOfYear + 2) / 153;
+            month = shiftedMonth < 10 ? shiftedMonth + 3 : shiftedMonth - 9;
+            year = static_cast<std::int64_t>(yearOfEra) + era * 400 + (month <= 2);
+        }
+
+        // Weeks start on Monday; 1970-01-01 was a Thursday
+        std::int64_t weekKeyOfDay(std::int64_t day) noexcept {
+            return floorDiv(day + 3, 7);
+        }
+
+        std::int64_t monthKeyOfDay(std::int64_t day) noexcept {
+            std::int64_t year = 0;
+            unsigned month = 1;
+            civilFromDays(day, year, month);
+            return year * 12 + (month - 1);
+        }
+
+    } // namespace
+
+    RollupTable::RollupTable(std::chrono::minutes utcOffset)
+        : utcOffset_(utcOffset) {
+    }
+
+    void RollupTable::Series::add(std::int64_t key, std::int64_t milliseconds) {
+        if (totals.empty()) {
+            last = key;
+            totals.push_back(0);
+        }
+        else if (key > last) {
+            totals.resize(totals.size() + static_cast<std::size_t>(key - last), 0);
+            last = key;
+        }
+        else if (key < first()) {
+            // Only a session older than every stored one (e.g. after a clock step)
+            totals.insert(totals.begin(), static_cast<std::size_t>(first() - key), 0);
+        }
+
+        totals[totals.size() - 1 - static_cast<std::size_t>(last - key)] += milliseconds;
+    }
+
+    std::int64_t RollupTable::Series::get(std::int64_t key) const noexcept {
+        const std::int64_t fromEnd = last - key;
+        if (fromEnd < 0 || fromEnd >= static_cast<std::int64_t>(totals.size())) {
+            return 0;
+        }
+        return totals[totals.size() - 1 - static_cast<std::size_t>(fromEnd)];
+    }
+
+    void RollupTable::addSession(WallTime start, WallTime end) {
+        const std::int64_t offsetMs = std::chrono::duration_cast<Timer::Duration>(utcOffset_).count();
+        std::int64_t localMs = start.time_since_epoch().count() + offsetMs;
+        const std::int64_t localEndMs = end.time_since_epoch().count() + offsetMs;
+
+        // Split at local midnights so each day gets its own share
+        while (localMs < localEndMs) {
+            const std::int64_t day = floorDiv(localMs, kMsPerDay);
+            const std::int64_t sliceEnd = std::min(localEndMs, (day + 1) * kMsPerDay);
+            const std::int64_t slice = sliceEnd - localMs;
+
+            days_.add(day, slice);
+            weeks_.add(weekKeyOfDay(day), slice);
+            months_.add(monthKeyOfDay(day), slice);
+
+            localMs = sliceEnd;
+        }
+        dirty_ = true;
+    }
+
+    std::size_t RollupTable::catchUp(SessionStore& store) {
+        if (store.getSessionCount() < appliedSessions_) {
+            clear(); // The store was rebuilt or replaced underneath us
+        }
+
+        const std::size_t before = appliedSessions_;
+        store.forEachSessionSince(appliedSessions_, [this](const SessionRecord& session) {
+            addSession(session.start, session.end);
+            ++appliedSessions_;
+        });
+        return appliedSessions_ - before;
+    }
+
+    void RollupTable::clear() {
+        days_ = Series();
+        weeks_ = Series();
+        months_ = Series();
+        appliedSessions_ = 0;
+        dirty_ = true;
+    }
+
+    Timer::Duration RollupTable::getDayTotal(int year, unsigned month, unsigned day) const {
+        return Timer::Duration(days_.get(daysFromCivil(year, month, day)));
+    }
+
+    Timer::Duration RollupTable::getWeekTotal(int isoYear, unsigned isoWeek) const {
+        // ISO week 1 is the week containing January 4th, the last one the week
+        // containing December 28th; week keys are dense, so anything past that
+        // would read the next year's weeks
+        const std::int64_t week1 = weekKeyOfDay(daysFromCivil(isoYear, 1, 4));
+        const std::int64_t weeksInYear = weekKeyOfDay(daysFromCivil(isoYear, 12, 28)) - week1 + 1;
+        if (isoWeek < 1 || isoWeek > weeksInYear) {
+            return Timer::Duration::zero();
+        }
+        return Timer::Duration(weeks_.get(week1 + isoWeek - 1));
+    }
+
+    Timer::Duration RollupTable::getMonthTotal(int year, unsigned month) const {
+        if (month < 1 || month > 12) {
+            return Timer::Duration::zero();
+        }
+        return Timer::Duration(months_.get(static_cast<std::int64_t>(year) * 12 + (month - 1)));
+    }
+
+    Timer::Duration RollupTable::getDayTotal(WallTime at) const {
+        return Timer::Duration(days_.get(localDayOf(at.time_since_epoch().count())));
+    }
+
+    Timer::Duration RollupTable::getWeekTotal(WallTime at) const {
+        return Timer::Duration(weeks_.get(weekKeyOfDay(localDayOf(at.time_since_epoch().count()))));
+    }
+
+    Timer::Duration RollupTable::getMonthTotal(WallTime at) const {
+        return Timer::Duration(months_.get(monthKeyOfDay(localDayOf(at.time_since_epoch().count()))));
+    }
+
+    std::int64_t RollupTable::localDayOf(std::int64_t wallMs) const noexcept {
+        const std::int64_t offsetMs = std::chrono::duration_cast<Timer::Duration>(utcOffset_).count();
+        return floorDiv(wallMs + offsetMs, kMsPerDay);
+    }
+
+    std::chrono::minutes RollupTable::getLocalUtcOffset() {
+        const std::time_t now = std::time(nullptr);
+        std::tm local{};
+        std::tm utc{};
+#if defined(_WIN32)
+        localtime_s(&local, &now);
+        gmtime_s(&utc, &now);
+#else
+        localtime_r(&now, &local);
+        gmtime_r(&now, &utc);
+#endif
+
+        const auto minutesOf = [](const std::tm& time) {
+            const std::int64_t day = daysFromCivil(time.tm_year + 1900,
+                static_cast<unsigned>(time.tm_mon + 1), static_cast<unsigned>(time.tm_mday));
+            return day * 1440 + time.tm_hour * 60 + time.tm_min;
+        };
+        return std::chrono::minutes(minutesOf(local) - minutesOf(utc));
+    }
+
+    bool RollupTable::load(const std::string& path) {
+        clear();
+        dirty_ = false;
+
+        std::FILE* file = std::fopen(path.c_str(), "rb");
+        if (!file) {
+            return false;
+        }
+
+        std::vector<unsigned char> bytes;
+        unsigned char buffer[16384];
+        std::size_t read = 0;
+        while ((read = std::fread(buffer, 1, sizeof(buffer), file)) > 0) {
+            bytes.insert(bytes.end(), buffer, buffer + read);
+        }
+        std::fclose(file);
+
+        if (bytes.size() < kHeaderSize ||
+            std::memcmp(bytes.data(), kMagic, sizeof(kMagic)) != 0 ||
+            loadU32(bytes.data() + 8) != kFormatVersion) {
+            return false;
+        }
+
+        // Totals bucketed for another time zone are useless here; rebuild instead
+        const auto offsetMinutes = static_cast<std::int32_t>(loadU32(bytes.data() + 12));
+        if (offsetMinutes != utcOffset_.count()) {
+            return false;
+        }
+
+        std::size_t position = kHeaderSize;
+        for (Series* series : { &days_, &weeks_, &months_ }) {
+            if (bytes.size() - position < 16) {
+                clear();
+                return false;
+            }
+            const std::int64_t base = loadI64(bytes.data() + position);
+            const std::int64_t count = loadI64(bytes.data() + position + 8);
+            position += 16;
+            if (count < 0 || static_cast<std::uint64_t>(count) > (bytes.size() - position) / 8) {
+                clear();
+                return false;
+            }
+
+            series->last = base + count - 1;
+            series->totals.resize(static_cast<std::size_t>(count));
+            for (auto& total : series->totals) {
+                total = loadI64(bytes.data() + position);
+                position += 8;
+            }
+        }
+
+        appliedSessions_ = static_cast<std::size_t>(loadI64(bytes.data() + 16));
+        dirty_ = false;
+        return true;
+    }
+
+    bool RollupTable::save(const std::string& path) const {
+        const std::size_t size = kHeaderSize + 16 * 3 +
+            8 * (days_.totals.size() + weeks_.totals.size() + months_.totals.size());
+        std::vector<unsigned char> bytes(size, 0);
+
+        std::memcpy(bytes.data(), kMagic, sizeof(kMagic));
+        storeU32(bytes.data() + 8, kFormatVersion);
+        storeU32(bytes.data() + 12, static_cast<std::uint32_t>(static_cast<std::int32_t>(utcOffset_.count())));
+        storeI64(bytes.data() + 16, static_cast<std::int64_t>(appliedSessions_));
+
+        std::size_t position = kHeaderSize;
+        for (const Series* series : { &days_, &weeks_, &months_ }) {
+            storeI64(bytes.data() + position, series->first());
+            storeI64(bytes.data() + position + 8, static_cast<std::int64_t>(series->totals.size()));
+            position += 16;
+            for (const auto total : series->totals) {
+                storeI64(bytes.data() + position, total);
+                position += 8;
+            }
+        }
+
+        if (!replaceFile(path, bytes.data(), bytes.size())) {
+            return false;
+        }
+        dirty_ = false;
+        return true;
+    }
+
+} // namespace LockedAndFlow
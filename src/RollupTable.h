@@ -0,0 +1,75 @@
+#pragma once
+
+#include "SessionStore.h"
+#include <chrono>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace LockedAndFlow {
+
+    /**
+     * @brief Pre-aggregated focus totals per day, ISO week and month
+     *
+     * Each table is a dense array of totals indexed by a day / week / month
+     * number, so a lookup is one subtraction and one load. Sessions are added
+     * as they end and split at local midnight, so adding one costs O(days it
+     * spans). Local time uses a fixed UTC offset chosen at construction
+     * (daylight-saving changes are not tracked).
+     *
+     * The table remembers how many SessionStore sessions it has absorbed, so
+     * catchUp() after a restart only reads sessions appended since the last save.
+     */
+    class RollupTable {
+    public:
+        explicit RollupTable(std::chrono::minutes utcOffset = getLocalUtcOffset());
+
+        // Persistence alongside the session store
+        bool load(const std::string& path);
+        bool save(const std::string& path) const;
+
+        // Incremental maintenance
+        void addSession(WallTime start, WallTime end);
+        std::size_t catchUp(SessionStore& store);   // @return sessions added
+        void clear();
+
+        // Constant-time queries (local calendar)
+        Timer::Duration getDayTotal(int year, unsigned month, unsigned day) const;
+        Timer::Duration getWeekTotal(int isoYear, unsigned isoWeek) const;
+        Timer::Duration getMonthTotal(int year, unsigned month) const;
+
+        // Queries for the day / ISO week / month containing @p at
+        Timer::Duration getDayTotal(WallTime at) const;
+        Timer::Duration getWeekTotal(WallTime at) const;
+        Timer::Duration getMonthTotal(WallTime at) const;
+
+        std::chrono::minutes getUtcOffset() const noexcept { return utcOffset_; }
+        std::size_t getAppliedSessionCount() const noexcept { return appliedSessions_; }
+        bool isDirty() const noexcept { return dirty_; }
+
+        // Offset of the system's local time zone right now
+        static std::chrono::minutes getLocalUtcOffset();
+
+    private:
+        // Dense totals for consecutive keys ending at `last`. Sessions arrive in
+        // time order, so a new key is appended and lookups index from the end.
+        struct Series {
+            std::int64_t last = 0;
+            std::vector<std::int64_t> totals;
+
+            std::int64_t first() const noexcept { return last - static_cast<std::int64_t>(totals.size()) + 1; }
+            void add(std::int64_t key, std::int64_t milliseconds);
+            std::int64_t get(std::int64_t key) const noexcept;
+        };
+
+        std::chrono::minutes utcOffset_;
+        Series days_;
+        Series weeks_;
+        Series months_;
+        std::size_t appliedSessions_ = 0;
+        mutable bool dirty_ = false;
+
+        std::int64_t localDayOf(std::int64_t wallMs) const noexcept;
+    };
+
+} // namespace LockedAndFlow
@@ -0,0 +1,95 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <thread>
+#include <type_traits>
+
+namespace LockedAndFlow {
+
+    /**
+     * @brief Single-writer sequence lock around a trivially copyable value
+     *
+     * The writer bumps a sequence number to odd, stores the value and bumps it
+     * back to even; it never waits for anyone. A reader copies the value
+     * between two reads of the sequence and retries only if a write overlapped,
+     * so readers never block the writer and never see a torn value. The payload
+     * is stored as relaxed atomic words (the data-race-free seqlock pattern).
+     *
+     * @tparam T Trivially copyable value; only one thread may call write()
+     */
+    template <typename T>
+    class Seqlock {
+        static_assert(std::is_trivially_copyable_v<T>, "Seqlock values are copied word by word");
+
+    public:
+        Seqlock() noexcept : Seqlock(T{}) {}
+        explicit Seqlock(const T& initial) noexcept { storeWords(initial); }
+
+        Seqlock(const Seqlock&) = delete;
+        Seqlock& operator=(const Seqlock&) = delete;
+
+        // Writer thread only
+        void write(const T& value) noexcept {
+            const std::uint64_t sequence = sequence_.load(std::memory_order_relaxed);
+            sequence_.store(sequence + 1, std::memory_order_relaxed);
+            std::atomic_thread_fence(std::memory_order_release);
+            storeWords(value);
+            sequence_.store(sequence + 2, std::memory_order_release);
+        }
+
+        // Any thread. @return false if a write was in progress (value untouched)
+        bool tryRead(T& value) const noexcept {
+            const std::uint64_t before = sequence_.load(std::memory_order_acquire);
+            if (before & 1) {
+                return false;
+            }
+
+            std::array<std::uint64_t, kWords> words;
+            for (std::size_t i = 0; i < kWords; ++i) {
+                words[i] = words_[i].load(std::memory_order_relaxed);
+            }
+            std::atomic_thread_fence(std::memory_order_acquire);
+            if (sequence_.load(std::memory_order_relaxed) != before) {
+                return false;
+            }
+
+            // Byte copy, as T may have default member initializers (still trivially copyable)
+            std::memcpy(reinterpret_cast<unsigned char*>(&value), words.data(), sizeof(T));
+            return true;
+        }
+
+        // Any thread; retries while a write overlaps
+        T read() const noexcept {
+            T value;
+            for (unsigned attempt = 0; !tryRead(value); ++attempt) {
+                if (attempt >= kSpinsBeforeYield) {
+                    std::this_thread::yield(); // The writer was preempted mid-write
+                }
+            }
+            return value;
+        }
+
+        // Incremented twice per write
+        std::uint64_t getSequence() const noexcept { return sequence_.load(std::memory_order_acquire); }
+
+    private:
+        static constexpr std::size_t kWords = (sizeof(T) + sizeof(std::uint64_t) - 1) / sizeof(std::uint64_t);
+        static constexpr unsigned kSpinsBeforeYield = 64;
+
+        std::atomic<std::uint64_t> sequence_{ 0 };
+        std::array<std::atomic<std::uint64_t>, kWords> words_;
+
+        void storeWords(const T& value) noexcept {
+            std::array<std::uint64_t, kWords> words{};
+            std::memcpy(words.data(), &value, sizeof(T));
+            for (std::size_t i = 0; i < kWords; ++i) {
+                words_[i].store(words[i], std::memory_order_relaxed);
+            }
+        }
+    };
+
+} // namespace LockedAndFlow
@@ -0,0 +1,326 @@
+#include "SessionJournal.h"
+#include "FileIO.h"
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+#include <vector>
+
+namespace LockedAndFlow {
+
+    using namespace FileIO;
+
+    namespace {
+
+        // File header: magic, format version, record size, zero padding
+        constexpr unsigned char kMagic[8] = { 'L', 'A', 'F', 'J', 'R', 'N', 'L', '\0' };
+        constexpr std::uint32_t kFormatVersion = 1;
+        constexpr std::size_t kHeaderSize = 32;
+        constexpr std::size_t kChecksumOffset = 28;
+
+        // FNV-1a, enough to tell a torn or garbage record from a real one
+        std::uint32_t checksum(const unsigned char* data, std::size_t size) noexcept {
+            std::uint32_t hash = 2166136261u;
+            for (std::size_t i = 0; i < size; ++i) {
+                hash = (hash ^ data[i]) * 16777619u;
+            }
+            return hash;
+        }
+
+        void encodeHeader(unsigned char* out) noexcept {
+            std::memset(out, 0, kHeaderSize);
+            std::memcpy(out, kMagic, sizeof(kMagic));
+            storeU32(out + 8, kFormatVersion);
+            storeU32(out + 12, static_cast<std::uint32_t>(JournalRecord::kEncodedSize));
+        }
+
+        bool isValidHeader(const unsigned char* in) noexcept {
+            return std::memcmp(in, kMagic, sizeof(kMagic)) == 0 &&
+                loadU32(in + 8) == kFormatVersion &&
+                loadU32(in + 12) == JournalRecord::kEncodedSize;
+        }
+
+        enum class ScanResult {
+            Missing,
+            Empty,
+            NotAJournal,
+            Ok
+        };
+
+        // Reads the journal in large chunks; stops at the first invalid record.
+        // validBytes receives the length of the header plus the valid prefix.
+        ScanResult scanJournal(const std::string& path, const std::function<void(const JournalRecord&)>& visitor,
+            std::uint64_t& validBytes) {
+            validBytes = 0;
+
+            std::FILE* file = std::fopen(path.c_str(), "rb");
+            if (!file) {
+                return ScanResult::Missing;
+            }
+
+            unsigned char header[kHeaderSize];
+            const std::size_t headerRead = std::fread(header, 1, kHeaderSize, file);
+            if (headerRead == 0) {
+                std::fclose(file);
+                return ScanResult::Empty;
+            }
+            if (headerRead < kHeaderSize || !isValidHeader(header)) {
+                std::fclose(file);
+                return ScanResult::NotAJournal;
+            }
+            validBytes = kHeaderSize;
+
+            constexpr std::size_t kChunkRecords = 2048;
+            std::vector<unsigned char> chunk(kChunkRecords * JournalRecord::kEncodedSize);
+            bool valid = true;
+
+            while (valid) {
+                const std::size_t bytes = std::fread(chunk.data(), 1, chunk.size(), file);
+                const std::size_t records = bytes / JournalRecord::kEncodedSize;
+
+                for (std::size_t i = 0; i < records; ++i) {
+                    JournalRecord record;
+                    if (!JournalRecord::decode(chunk.data() + i * JournalRecord::kEncodedSize, record)) {
+                        valid = false;
+                        break;
+                    }
+                    validBytes += JournalRecord::kEncodedSize;
+                    visitor(record);
+                }
+
+                if (bytes < chunk.size()) {
+                    break; // End of file (a partial trailing record is a torn write)
+                }
+            }
+
+            std::fclose(file);
+            return ScanResult::Ok;
+        }
+
+    } // namespace
+
+    JournalRecord JournalRecord::fromTimer(JournalEvent event, const Timer& timer, WallTime at, Timer::TimePoint steadyAt) {
+        JournalRecord record;
+        record.wallTimeMs = at.time_since_epoch().count();
+        record.elapsedMs = timer.getElapsed(steadyAt).count();
+        record.targetMs = timer.getTargetDuration() ? timer.getTargetDuration()->count() : -1;
+        record.event = event;
+        record.state = timer.getState();
+        return record;
+    }
+
+    void JournalRecord::encode(unsigned char* out) const noexcept {
+        storeI64(out, wallTimeMs);
+        storeI64(out + 8, elapsedMs);
+        storeI64(out + 16, targetMs);
+        out[24] = static_cast<unsigned char>(event);
+        out[25] = static_cast<unsigned char>(state);
+        out[26] = 0;
+        out[27] = 0;
+        storeU32(out + kChecksumOffset, checksum(out, kChecksumOffset));
+    }
+
+    bool JournalRecord::decode(const unsigned char* in, JournalRecord& record) noexcept {
+        if (loadU32(in + kChecksumOffset) != checksum(in, kChecksumOffset)) {
+            return false;
+        }
+        if (in[24] < static_cast<unsigned char>(JournalEvent::Start) ||
+            in[24] > static_cast<unsigned char>(JournalEvent::TargetChanged) ||
+            in[25] > static_cast<unsigned char>(TimerState::Paused)) {
+            return false;
+        }
+
+        record.wallTimeMs = loadI64(in);
+        record.elapsedMs = loadI64(in + 8);
+        record.targetMs = loadI64(in + 16);
+        record.event = static_cast<JournalEvent>(in[24]);
+        record.state = static_cast<TimerState>(in[25]);
+        return true;
+    }
+
+    SessionJournal::~SessionJournal() {
+        close();
+    }
+
+    bool SessionJournal::open(const std::string& path, JournalSyncPolicy policy) {
+        close();
+
+        recordCount_ = 0;
+        lastRecord_.reset();
+
+        std::uint64_t validBytes = 0;
+        const auto scan = scanJournal(path, [this](const JournalRecord& record) {
+            ++recordCount_;
+            lastRecord_ = record;
+        }, validBytes);
+
+        if (scan == ScanResult::NotAJournal) {
+            return false; // Never append to (or truncate) somebody else's file
+        }
+
+        fd_ = openForAppend(path);
+        if (fd_ < 0) {
+            return false;
+        }
+
+        if (scan == ScanResult::Ok) {
+            // Drop a torn or corrupt tail so new records follow the valid prefix
+            if (!truncateFile(fd_, validBytes)) {
+                close();
+                return false;
+            }
+        }
+        else {
+            unsigned char header[kHeaderSize];
+            encodeHeader(header);
+            if (!truncateFile(fd_, 0) || !writeAll(fd_, header, kHeaderSize) || !syncFile(fd_)) {
+                close();
+                return false;
+            }
+        }
+
+        policy_ = policy;
+        if (policy_.everyN == 0) {
+            policy_.everyN = 1;
+        }
+        pendingCount_ = 0;
+        unsyncedCount_ = 0;
+        lastSync_ = std::chrono::steady_clock::now();
+        return true;
+    }
+
+    void SessionJournal::close() {
+        if (fd_ < 0) {
+            return;
+        }
+
+        flush();
+        closeFile(fd_);
+        fd_ = -1;
+    }
+
+    bool SessionJournal::append(JournalEvent event, const Timer& timer, WallTime at) {
+        return append(JournalRecord::fromTimer(event, timer, at));
+    }
+
+    bool SessionJournal::append(const JournalRecord& record) {
+        if (fd_ < 0) {
+            return false;
+        }
+
+        record.encode(batch_.data() + pendingCount_ * JournalRecord::kEncodedSize);
+        ++pendingCount_;
+        ++unsyncedCount_;
+        ++recordCount_;
+        lastRecord_ = record;
+
+        switch (policy_.mode) {
+        case JournalSyncMode::EveryEvent:
+            return flush();
+        case JournalSyncMode::EveryN:
+            if (unsyncedCount_ >= policy_.everyN) {
+                return flush();
+            }
+            break;
+        case JournalSyncMode::Interval:
+            if (std::chrono::steady_clock::now() - lastSync_ >= policy_.interval) {
+                return flush();
+            }
+            break;
+        }
+
+        // Batch full but no sync due yet: hand it to the OS without fsync
+        if (pendingCount_ == kBatchCapacity) {
+            return writePending();
+        }
+        return true;
+    }
+
+    bool SessionJournal::flush() {
+        if (fd_ < 0) {
+            return false;
+        }
+        if (unsyncedCount_ == 0) {
+            return true;
+        }
+        return writePending() && sync();
+    }
+
+    bool SessionJournal::flushIfDue() {
+        if (fd_ < 0 || unsyncedCount_ == 0) {
+            return true;
+        }
+        if (policy_.mode == JournalSyncMode::Interval &&
+            std::chrono::steady_clock::now() - lastSync_ < policy_.interval) {
+            return true;
+        }
+        return flush();
+    }
+
+    std::optional<std::chrono::milliseconds> SessionJournal::getTimeUntilFlushDue(
+        std::chrono::steady_clock::time_point now) const {
+        if (fd_ < 0 || unsyncedCount_ == 0) {
+            return std::nullopt;
+        }
+        if (policy_.mode != JournalSyncMode::Interval) {
+            return std::chrono::milliseconds::zero();
+        }
+
+        const auto sinceSync = std::chrono::duration_cast<std::chrono::milliseconds>(now - lastSync_);
+        return std::max(policy_.interval - sinceSync, std::chrono::milliseconds::zero());
+    }
+
+    bool SessionJournal::writePending() {
+        if (pendingCount_ == 0) {
+            return true;
+        }
+
+        const bool written = writeAll(fd_, batch_.data(), pendingCount_ * JournalRecord::kEncodedSize);
+        pendingCount_ = 0;
+        return written;
+    }
+
+    bool SessionJournal::sync() {
+        unsyncedCount_ = 0;
+        lastSync_ = std::chrono::steady_clock::now();
+        return syncFile(fd_);
+    }
+
+    bool SessionJournal::restoreTimer(Timer& timer, WallTime wallNow, Timer::TimePoint steadyNow) const {
+        if (!lastRecord_) {
+            return false;
+        }
+
+        const auto& record = *lastRecord_;
+        timer.reset();
+        timer.saveElapsed(Timer::Duration(record.elapsedMs));
+        if (record.targetMs >= 0) {
+            timer.setTargetDuration(Timer::Duration(record.targetMs));
+        }
+
+        // Re-enter the recorded state with a start instant in the past, so a
+        // running timer adds the time since its last record to the elapsed time
+        // recorded then
+        const auto sinceRecord = std::max(Timer::Duration::zero(),
+            wallNow - WallTime(Timer::Duration(record.wallTimeMs)));
+        const auto startTime = steadyNow - sinceRecord;
+
+        switch (record.state) {
+        case TimerState::Running:
+            timer.start(startTime);
+            break;
+        case TimerState::Paused:
+            timer.start(startTime);
+            timer.pause(startTime);
+            break;
+        case TimerState::Stopped:
+            break;
+        }
+        return true;
+    }
+
+    bool SessionJournal::replay(const std::string& path, const std::function<void(const JournalRecord&)>& visitor) {
+        std::uint64_t validBytes = 0;
+        return scanJournal(path, visitor, validBytes) == ScanResult::Ok;
+    }
+
+} // namespace LockedAndFlow
@@ -0,0 +1,139 @@
+#pragma once
+
+#include "Timer.h"
+#include <array>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <optional>
+#include <string>
+
+namespace LockedAndFlow {
+
+    // Timer::TimePoint is a steady_clock reading and means nothing after the process
+    // exits, so persisted history uses wall-clock time at Timer::Duration resolution
+    using WallClock = std::chrono::system_clock;
+    using WallTime = std::chrono::time_point<WallClock, Timer::Duration>;
+
+    inline WallTime wallNow() {
+        return std::chrono::time_point_cast<Timer::Duration>(WallClock::now());
+    }
+
+    enum class JournalEvent : std::uint8_t {
+        Start = 1,
+        Pause,
+        Stop,
+        Reset,
+        TargetChanged
+    };
+
+    /**
+     * @brief One fixed-size (32 byte) journal entry
+     *
+     * Stores the Timer state *after* the transition, so the last valid record
+     * alone is enough to rebuild a Timer. Fields are encoded little-endian and the
+     * record carries a checksum, so torn or corrupt tails are detected on replay.
+     */
+    struct JournalRecord {
+        std::int64_t wallTimeMs = 0;      // WallTime of the transition, ms since epoch
+        std::int64_t elapsedMs = 0;       // Timer::getElapsed() at the transition, current run included
+        std::int64_t targetMs = -1;       // Target duration, -1 when none
+        JournalEvent event = JournalEvent::Start;
+        TimerState state = TimerState::Stopped;
+
+        static constexpr std::size_t kEncodedSize = 32;
+
+        static JournalRecord fromTimer(JournalEvent event, const Timer& timer, WallTime at) {
+            return fromTimer(event, timer, at, Timer::ClockType::now());
+        }
+        static JournalRecord fromTimer(JournalEvent event, const Timer& timer, WallTime at, Timer::TimePoint steadyAt);
+
+        void encode(unsigned char* out) const noexcept;
+        static bool decode(const unsigned char* in, JournalRecord& record) noexcept;
+    };
+
+    enum class JournalSyncMode {
+        EveryEvent, // write() + fsync per append
+        EveryN,     // write() + fsync once every `everyN` appends
+        Interval    // write() + fsync once `interval` has passed since the last sync
+    };
+
+    struct JournalSyncPolicy {
+        JournalSyncMode mode = JournalSyncMode::EveryN;
+        std::size_t everyN = 64;
+        std::chrono::milliseconds interval{ 1000 };
+
+        static JournalSyncPolicy everyEvent() { return { JournalSyncMode::EveryEvent, 1, {} }; }
+        static JournalSyncPolicy everyNEvents(std::size_t n) { return { JournalSyncMode::EveryN, n, {} }; }
+        static JournalSyncPolicy everyInterval(std::chrono::milliseconds interval) {
+            return { JournalSyncMode::Interval, 0, interval };
+        }
+    };
+
+    /**
+     * @brief Append-only binary journal of Timer state transitions
+     *
+     * Records are encoded into an in-memory batch and reach the file with a
+     * single write() per batch followed by fsync, as the sync policy dictates.
+     * Opening an existing journal validates it, drops a torn tail left by a
+     * crash, and remembers the last record for restoreTimer().
+     */
+    class SessionJournal {
+    public:
+        SessionJournal() = default;
+        ~SessionJournal();
+
+        SessionJournal(const SessionJournal&) = delete;
+        SessionJournal& operator=(const SessionJournal&) = delete;
+
+        // File management
+        bool open(const std::string& path, JournalSyncPolicy policy = {});
+        void close();
+        bool isOpen() const noexcept { return fd_ >= 0; }
+
+        // Appending
+        bool append(JournalEvent event, const Timer& timer, WallTime at);
+        bool append(const JournalRecord& record);
+        bool flush();          // Write the pending batch and fsync
+        bool flushIfDue();     // For the Interval policy: call when idle
+
+        // How long an idle caller may sleep before flushIfDue() has work; empty if nothing is unsynced
+        std::optional<std::chrono::milliseconds> getTimeUntilFlushDue(std::chrono::steady_clock::time_point now) const;
+
+        // Journal contents
+        std::size_t getRecordCount() const noexcept { return recordCount_; }
+        std::size_t getPendingCount() const noexcept { return pendingCount_; }
+        const std::optional<JournalRecord>& getLastRecord() const noexcept { return lastRecord_; }
+
+        /**
+         * @brief Rebuilds a freshly constructed Timer from the last record
+         *
+         * A timer that was running when the journal ended is resumed as if it
+         * had kept running since that record. @return false if nothing to restore.
+         */
+        bool restoreTimer(Timer& timer, WallTime wallNow, Timer::TimePoint steadyNow) const;
+
+        /**
+         * @brief Streams every valid record of a journal file to @p visitor
+         * @return false if the file is missing or not a journal
+         */
+        static bool replay(const std::string& path, const std::function<void(const JournalRecord&)>& visitor);
+
+    private:
+        static constexpr std::size_t kBatchCapacity = 256;
+
+        int fd_ = -1;
+        JournalSyncPolicy policy_;
+        std::array<unsigned char, kBatchCapacity * JournalRecord::kEncodedSize> batch_{};
+        std::size_t pendingCount_ = 0;
+        std::size_t unsyncedCount_ = 0;
+        std::size_t recordCount_ = 0;
+        std::chrono::steady_clock::time_point lastSync_;
+        std::optional<JournalRecord> lastRecord_;
+
+        bool writePending();
+        bool sync();
+    };
+
+} // namespace LockedAndFlow
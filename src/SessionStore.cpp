@@ -0,0 +1,311 @@
+#include "SessionStore.h"
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+
+namespace LockedAndFlow {
+
+    using namespace FileIO;
+
+    namespace {
+
+        constexpr unsigned char kMagic[8] = { 'L', 'A', 'F', 'S', 'E', 'S', 'S', '\0' };
+        constexpr std::uint32_t kFormatVersion = 1;
+        constexpr std::size_t kHeaderSize = 32;
+        constexpr std::size_t kRecordSize = 16; // start ms, end ms
+
+        std::int64_t startOf(const unsigned char* record) noexcept { return loadI64(record); }
+        std::int64_t endOf(const unsigned char* record) noexcept { return loadI64(record + 8); }
+
+        std::string indexPathFor(const std::string& path) {
+            return path + ".idx";
+        }
+
+        bool readHeader(const std::string& path, bool& exists) {
+            exists = false;
+            std::FILE* file = std::fopen(path.c_str(), "rb");
+            if (!file) {
+                return true;
+            }
+
+            unsigned char header[kHeaderSize];
+            const std::size_t read = std::fread(header, 1, kHeaderSize, file);
+            std::fclose(file);
+            if (read == 0) {
+                return true; // Empty file, treated like a new one
+            }
+
+            exists = true;
+            return read == kHeaderSize &&
+                std::memcmp(header, kMagic, sizeof(kMagic)) == 0 &&
+                loadU32(header + 8) == kFormatVersion &&
+                loadU32(header + 12) == kRecordSize;
+        }
+
+    } // namespace
+
+    SessionStore::~SessionStore() {
+        close();
+    }
+
+    bool SessionStore::open(const std::string& path) {
+        close();
+
+        bool exists = false;
+        if (!readHeader(path, exists)) {
+            return false; // Not a session store
+        }
+
+        fd_ = openForAppend(path);
+        if (fd_ < 0) {
+            return false;
+        }
+        path_ = path;
+
+        if (!exists) {
+            unsigned char header[kHeaderSize] = {};
+            std::memcpy(header, kMagic, sizeof(kMagic));
+            storeU32(header + 8, kFormatVersion);
+            storeU32(header + 12, kRecordSize);
+            if (!truncateFile(fd_, 0) || !writeAll(fd_, header, kHeaderSize) || !syncFile(fd_)) {
+                close();
+                return false;
+            }
+        }
+
+        if (!mapping_.map(path_)) {
+            close();
+            return false;
+        }
+
+        // Drop a partially written trailing record
+        sessionCount_ = (mapping_.size() - kHeaderSize) / kRecordSize;
+        const auto validBytes = kHeaderSize + sessionCount_ * kRecordSize;
+        if (validBytes != mapping_.size()) {
+            mapping_.unmap(); // Windows refuses to truncate a mapped file
+            if (!truncateFile(fd_, validBytes) || !mapping_.map(path_)) {
+                close();
+                return false;
+            }
+        }
+        mappingStale_ = false;
+        lastEndMs_ = sessionCount_ > 0 ? endOf(sessionAt(sessionCount_ - 1)) : 0;
+
+        if (!loadIndex(sessionCount_)) {
+            close();
+            return false;
+        }
+        return true;
+    }
+
+    void SessionStore::close() {
+        mapping_.unmap();
+        if (fd_ >= 0) {
+            closeFile(fd_);
+            fd_ = -1;
+        }
+        if (indexFd_ >= 0) {
+            closeFile(indexFd_);
+            indexFd_ = -1;
+        }
+
+        sparseIndex_.clear();
+        sessionCount_ = 0;
+        lastEndMs_ = 0;
+        running_ = false;
+        mappingStale_ = true;
+    }
+
+    bool SessionStore::loadIndex(std::size_t sessionCount) {
+        const auto indexPath = indexPathFor(path_);
+        const std::size_t expected = (sessionCount + kIndexStride - 1) / kIndexStride;
+
+        sparseIndex_.clear();
+        if (std::FILE* file = std::fopen(indexPath.c_str(), "rb")) {
+            unsigned char entry[8];
+            while (sparseIndex_.size() < expected && std::fread(entry, 1, sizeof(entry), file) == sizeof(entry)) {
+                sparseIndex_.push_back(loadI64(entry));
+            }
+            std::fclose(file);
+        }
+
+        // Verify against the data file; rebuild the side file on any mismatch
+        bool consistent = sparseIndex_.size() == expected;
+        for (std::size_t block = 0; consistent && block < expected; ++block) {
+            consistent = sparseIndex_[block] == startOf(sessionAt(block * kIndexStride));
+        }
+
+        indexFd_ = openForAppend(indexPath);
+        if (indexFd_ < 0) {
+            return false;
+        }
+        if (consistent) {
+            return truncateFile(indexFd_, expected * 8);
+        }
+
+        sparseIndex_.clear();
+        std::vector<unsigned char> bytes(expected * 8);
+        for (std::size_t block = 0; block < expected; ++block) {
+            sparseIndex_.push_back(startOf(sessionAt(block * kIndexStride)));
+            storeI64(bytes.data() + block * 8, sparseIndex_.back());
+        }
+        return truncateFile(indexFd_, 0) && writeAll(indexFd_, bytes.data(), bytes.size());
+    }
+
+    bool SessionStore::append(WallTime start, WallTime end) {
+        if (fd_ < 0) {
+            return false;
+        }
+
+        const std::int64_t startMs = std::max(start.time_since_epoch().count(), lastEndMs_);
+        const std::int64_t endMs = end.time_since_epoch().count();
+        if (endMs <= startMs) {
+            return true; // Empty after clamping, nothing to store
+        }
+
+        unsigned char record[kRecordSize];
+        storeI64(record, startMs);
+        storeI64(record + 8, endMs);
+        if (!writeAll(fd_, record, kRecordSize)) {
+            return false;
+        }
+
+        if (sessionCount_ % kIndexStride == 0) {
+            unsigned char entry[8];
+            storeI64(entry, startMs);
+            if (!writeAll(indexFd_, entry, sizeof(entry))) {
+                return false;
+            }
+            sparseIndex_.push_back(startMs);
+        }
+
+        ++sessionCount_;
+        lastEndMs_ = endMs;
+        mappingStale_ = true;
+        return true;
+    }
+
+    bool SessionStore::applyJournalRecord(const JournalRecord& record) {
+        if (record.state == TimerState::Running) {
+            // The record that starts a run holds the elapsed time before it; later
+            // records of the same run (a target change) include the run so far
+            if (!running_) {
+                running_ = true;
+                runBaseElapsedMs_ = record.elapsedMs;
+            }
+            return true;
+        }
+
+        if (!running_) {
+            return true;
+        }
+        running_ = false;
+
+        if (record.event != JournalEvent::Pause && record.event != JournalEvent::Stop) {
+            return true; // Reset drops the run, as Timer::reset() does
+        }
+
+        const Timer::Duration runLength(record.elapsedMs - runBaseElapsedMs_);
+        const WallTime end{ Timer::Duration(record.wallTimeMs) };
+        return append(end - runLength, end);
+    }
+
+    bool SessionStore::rebuildFromJournal(const std::string& journalPath) {
+        if (fd_ < 0) {
+            return false;
+        }
+
+        // Start over with an empty data and index file
+        mapping_.unmap();
+        if (!truncateFile(fd_, kHeaderSize) || !truncateFile(indexFd_, 0)) {
+            return false;
+        }
+        sparseIndex_.clear();
+        sessionCount_ = 0;
+        lastEndMs_ = 0;
+        running_ = false;
+        mappingStale_ = true;
+
+        bool ok = true;
+        const bool replayed = SessionJournal::replay(journalPath, [this, &ok](const JournalRecord& record) {
+            ok = applyJournalRecord(record) && ok;
+        });
+        return replayed && ok && syncFile(fd_) && syncFile(indexFd_);
+    }
+
+    Timer::Duration SessionStore::getFocusTime(WallTime from, WallTime to) {
+        Timer::Duration total = Timer::Duration::zero();
+        forEachSession(from, to, [&total, from, to](const SessionRecord& session) {
+            total += std::min(session.end, to) - std::max(session.start, from);
+        });
+        return total;
+    }
+
+    void SessionStore::forEachSession(WallTime from, WallTime to, const std::function<void(const SessionRecord&)>& visitor) {
+        if (!ensureMapped() || from >= to) {
+            return;
+        }
+
+        const std::int64_t fromMs = from.time_since_epoch().count();
+        const std::int64_t toMs = to.time_since_epoch().count();
+
+        for (std::size_t index = findFirstEndingAfter(fromMs); index < sessionCount_; ++index) {
+            const unsigned char* record = sessionAt(index);
+            const std::int64_t startMs = startOf(record);
+            if (startMs >= toMs) {
+                break;
+            }
+            visitor(SessionRecord{ WallTime(Timer::Duration(startMs)), WallTime(Timer::Duration(endOf(record))) });
+        }
+    }
+
+    void SessionStore::forEachSessionSince(std::size_t firstIndex, const std::function<void(const SessionRecord&)>& visitor) {
+        if (!ensureMapped()) {
+            return;
+        }
+
+        for (std::size_t index = firstIndex; index < sessionCount_; ++index) {
+            const unsigned char* record = sessionAt(index);
+            visitor(SessionRecord{ WallTime(Timer::Duration(startOf(record))), WallTime(Timer::Duration(endOf(record))) });
+        }
+    }
+
+    bool SessionStore::ensureMapped() {
+        if (fd_ < 0) {
+            return false;
+        }
+        if (mappingStale_) {
+            if (!mapping_.remap()) {
+                return false;
+            }
+            mappingStale_ = false;
+        }
+        return mapping_.size() >= kHeaderSize + sessionCount_ * kRecordSize;
+    }
+
+    const unsigned char* SessionStore::sessionAt(std::size_t index) const noexcept {
+        return mapping_.data() + kHeaderSize + index * kRecordSize;
+    }
+
+    std::size_t SessionStore::findFirstEndingAfter(std::int64_t timeMs) const {
+        // Last block starting at or before timeMs; earlier blocks end before it
+        const auto blockIt = std::upper_bound(sparseIndex_.begin(), sparseIndex_.end(), timeMs);
+        const std::size_t block = blockIt == sparseIndex_.begin() ? 0 :
+            static_cast<std::size_t>(blockIt - sparseIndex_.begin()) - 1;
+
+        // Sessions don't overlap, so end times are sorted too: binary search the block
+        std::size_t low = block * kIndexStride;
+        std::size_t high = std::min(sessionCount_, low + kIndexStride);
+        while (low < high) {
+            const std::size_t mid = low + (high - low) / 2;
+            if (endOf(sessionAt(mid)) <= timeMs) {
+                low = mid + 1;
+            }
+            else {
+                high = mid;
+            }
+        }
+        return low;
+    }
+
+} // namespace LockedAndFlow
@@ -0,0 +1,95 @@
+#pragma once
+
+#include "FileIO.h"
+#include "SessionJournal.h"
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <vector>
+
+namespace LockedAndFlow {
+
+    // One uninterrupted run of a timer, in wall-clock time
+    struct SessionRecord {
+        WallTime start;
+        WallTime end;
+
+        Timer::Duration getDuration() const noexcept { return end - start; }
+    };
+
+    /**
+     * @brief Memory-mapped, start-time-sorted store of focus sessions
+     *
+     * Sessions of one timer never overlap, so the segment file is sorted by
+     * both start and end time. Every kIndexStride-th start time is also kept
+     * in a small side file (`<path>.idx`), so a time-range query is a binary
+     * search over that sparse index, a short search inside one block of the
+     * mapping, and a sequential scan over the matching sessions. Nothing
+     * beyond the index is read into memory.
+     */
+    class SessionStore {
+    public:
+        static constexpr std::size_t kIndexStride = 512;
+
+        SessionStore() = default;
+        ~SessionStore();
+
+        SessionStore(const SessionStore&) = delete;
+        SessionStore& operator=(const SessionStore&) = delete;
+
+        // File management
+        bool open(const std::string& path);
+        void close();
+        bool isOpen() const noexcept { return fd_ >= 0; }
+
+        /**
+         * @brief Appends a session after the last stored one
+         *
+         * A start before the previous end (e.g. after a wall-clock step) is
+         * clamped to it; sessions that end up empty are dropped.
+         */
+        bool append(WallTime start, WallTime end);
+
+        /**
+         * @brief Derives sessions from journal records, live or during replay
+         *
+         * A run begins with the first Running record and ends, producing a
+         * session, at the next Pause or Stop. A Reset discards the run, like Timer does.
+         */
+        bool applyJournalRecord(const JournalRecord& record);
+
+        // Rebuilds the store from scratch out of a session journal
+        bool rebuildFromJournal(const std::string& journalPath);
+
+        // Queries
+        std::size_t getSessionCount() const noexcept { return sessionCount_; }
+        Timer::Duration getFocusTime(WallTime from, WallTime to);
+        void forEachSession(WallTime from, WallTime to, const std::function<void(const SessionRecord&)>& visitor);
+
+        // Sessions in append order starting at @p firstIndex, for derived tables catching up
+        void forEachSessionSince(std::size_t firstIndex, const std::function<void(const SessionRecord&)>& visitor);
+
+    private:
+        std::string path_;
+        int fd_ = -1;
+        int indexFd_ = -1;
+
+        FileIO::MappedFile mapping_;
+        bool mappingStale_ = true;
+
+        std::vector<std::int64_t> sparseIndex_; // Start of every kIndexStride-th session
+        std::size_t sessionCount_ = 0;
+        std::int64_t lastEndMs_ = 0;
+
+        // Open run tracked by applyJournalRecord()
+        bool running_ = false;
+        std::int64_t runBaseElapsedMs_ = 0;
+
+        bool loadIndex(std::size_t sessionCount);
+        bool ensureMapped();
+        const unsigned char* sessionAt(std::size_t index) const noexcept;
+        std::size_t findFirstEndingAfter(std::int64_t timeMs) const;
+    };
+
+} // namespace LockedAndFlow
@@ -0,0 +1,91 @@
+#include "StartupProfile.h"
+#include <cstdio>
+#include <ostream>
+
+namespace LockedAndFlow {
+
+    namespace {
+
+        // As close to process start as portable code gets
+        const StartupProfile::Clock::time_point processStart = StartupProfile::Clock::now();
+
+        double toMilliseconds(std::chrono::microseconds value) {
+            return static_cast<double>(value.count()) / 1000.0;
+        }
+
+    } // namespace
+
+    const char* toString(StartupMark mark) noexcept {
+        switch (mark) {
+        case StartupMark::WindowCreated:   return "window";
+        case StartupMark::FontLoaded:      return "font";
+        case StartupMark::DisplayCreated:  return "display";
+        case StartupMark::FirstFrame:      return "first frame";
+        case StartupMark::JournalReplayed: return "journal";
+        case StartupMark::HistoryLoaded:   return "history";
+        default: return "unknown";
+        }
+    }
+
+    StartupProfile::Clock::time_point StartupProfile::getProcessStart() noexcept {
+        return processStart;
+    }
+
+    StartupProfile::StartupProfile(Clock::time_point origin) noexcept
+        : origin_(origin) {
+    }
+
+    void StartupProfile::mark(StartupMark mark, Clock::time_point now) noexcept {
+        auto& slot = marks_[static_cast<std::size_t>(mark)];
+        if (!slot) {
+            slot = now;
+        }
+    }
+
+    bool StartupProfile::hasMark(StartupMark mark) const noexcept {
+        return marks_[static_cast<std::size_t>(mark)].has_value();
+    }
+
+    std::optional<std::chrono::microseconds> StartupProfile::getElapsed(StartupMark mark) const noexcept {
+        const auto& slot = marks_[static_cast<std::size_t>(mark)];
+        if (!slot) {
+            return std::nullopt;
+        }
+        return std::chrono::duration_cast<std::chrono::microseconds>(*slot - origin_);
+    }
+
+    bool StartupProfile::isFirstFrameOverBudget() const noexcept {
+        const auto firstFrame = getElapsed(StartupMark::FirstFrame);
+        return firstFrame && *firstFrame > kFirstFrameBudget;
+    }
+
+    void StartupProfile::writeReport(std::ostream& out) const {
+        char line[128];
+        const auto firstFrame = getElapsed(StartupMark::FirstFrame);
+        if (firstFrame) {
+            std::snprintf(line, sizeof(line), "Startup: first frame at %.2f ms (budget %lld ms%s)\n",
+                toMilliseconds(*firstFrame), static_cast<long long>(kFirstFrameBudget.count()),
+                isFirstFrameOverBudget() ? ", over" : "");
+        }
+        else {
+            std::snprintf(line, sizeof(line), "Startup: no frame presented\n");
+        }
+        out << line;
+        std::snprintf(line, sizeof(line), "  %-12s %9s %9s\n", "mark", "at ms", "step ms");
+        out << line;
+
+        std::chrono::microseconds previous{ 0 };
+        for (std::size_t i = 0; i < marks_.size(); ++i) {
+            const auto mark = static_cast<StartupMark>(i);
+            const auto elapsed = getElapsed(mark);
+            if (!elapsed) {
+                continue;
+            }
+            std::snprintf(line, sizeof(line), "  %-12s %9.2f %9.2f\n", toString(mark),
+                toMilliseconds(*elapsed), toMilliseconds(*elapsed - previous));
+            out << line;
+            previous = *elapsed;
+        }
+    }
+
+} // namespace LockedAndFlow
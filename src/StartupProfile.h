@@ -0,0 +1,59 @@
+#pragma once
+
+#include <array>
+#include <chrono>
+#include <cstddef>
+#include <iosfwd>
+#include <optional>
+
+namespace LockedAndFlow {
+
+    enum class StartupMark : std::size_t {
+        WindowCreated,      // The window exists (GL context included)
+        FontLoaded,         // Default font opened
+        DisplayCreated,     // First TimerDisplay constructed (glyph atlas baked)
+        FirstFrame,         // First frame presented
+        JournalReplayed,    // Previous session restored from the journal
+        HistoryLoaded,      // Session store and rollups loaded
+        Count
+    };
+
+    const char* toString(StartupMark mark) noexcept;
+
+    /**
+     * @brief Timestamps of the milestones between process start and a usable UI
+     *
+     * Each mark records the first time it is reached; later calls are
+     * ignored, so code that runs on every frame can mark unconditionally.
+     * Times are measured from getProcessStart(), taken during static
+     * initialisation (the dynamic loader's work before that is not counted).
+     * Recording is a clock read and a store, cheap enough to leave in release
+     * builds.
+     */
+    class StartupProfile {
+    public:
+        using Clock = std::chrono::steady_clock;
+
+        // Cold-start goal for the first presented frame
+        static constexpr std::chrono::milliseconds kFirstFrameBudget{ 100 };
+
+        static Clock::time_point getProcessStart() noexcept;
+
+        explicit StartupProfile(Clock::time_point origin = getProcessStart()) noexcept;
+
+        void mark(StartupMark mark, Clock::time_point now = Clock::now()) noexcept;
+
+        bool hasMark(StartupMark mark) const noexcept;
+        // Time from the origin to @p mark; empty if not reached yet
+        std::optional<std::chrono::microseconds> getElapsed(StartupMark mark) const noexcept;
+        bool isFirstFrameOverBudget() const noexcept;
+
+        // One row per reached mark: time since start and since the previous mark
+        void writeReport(std::ostream& out) const;
+
+    private:
+        Clock::time_point origin_;
+        std::array<std::optional<Clock::time_point>, static_cast<std::size_t>(StartupMark::Count)> marks_;
+    };
+
+} // namespace LockedAndFlow
@@ -1,7 +1,11 @@
 #pragma once
 
+#include "Delegate.h"
+#include "Seqlock.h"
+#include <algorithm>
+#include <array>
 #include <chrono>
-#include <functional>
+#include <cstdint>
 #include <optional>
 
 namespace LockedAndFlow {
@@ -12,29 +16,86 @@ namespace LockedAndFlow {
         Paused
     };
 
+    // Observer events; combine into a TimerEventMask to subscribe to several
+    enum class TimerEvent : std::uint8_t {
+        StateChanged = 1 << 0,  // Started, paused, stopped or reset
+        Tick = 1 << 1,          // Elapsed time reached a new whole second while running
+        TargetReached = 1 << 2  // update() stopped the timer at its target
+    };
+
+    using TimerEventMask = std::uint8_t;
+    constexpr TimerEventMask kAllTimerEvents = 0x07;
+
+    constexpr TimerEventMask operator|(TimerEvent a, TimerEvent b) noexcept {
+        return static_cast<TimerEventMask>(static_cast<TimerEventMask>(a) | static_cast<TimerEventMask>(b));
+    }
+    constexpr TimerEventMask operator|(TimerEventMask a, TimerEvent b) noexcept {
+        return static_cast<TimerEventMask>(a | static_cast<TimerEventMask>(b));
+    }
+
+    struct TimerNotification {
+        TimerEvent event;
+        TimerState state;               // State after the event
+        std::chrono::milliseconds elapsed;
+    };
+
     /**
      * @brief High-precision timer class for productivity tracking
      *
      * Provides start/stop/pause/reset functionality with millisecond precision
      * using std::chrono. Designed for productivity applications requiring
      * accurate time measurement and state management.
+     *
+     * @tparam Clock Time source with a static `now()` and a `time_point` type
+     *         (std::chrono clock requirements). Every operation that reads the
+     *         clock also has an overload taking `now`, so a caller can sample
+     *         the clock once per frame or batch and get consistent values.
+     *
+     * The timer itself is single-threaded. Other threads read it through an
+     * attached Publisher: every mutation republishes a Snapshot, from which any
+     * thread can compute elapsed time and progress without blocking the owner.
      */
 
-    class Timer {
+    template <typename Clock = std::chrono::steady_clock>
+    class BasicTimer {
     public:
+        using ClockType = Clock;
         using Duration = std::chrono::milliseconds;
-        using TimePoint = std::chrono::steady_clock::time_point;
-        using TimerCallback = std::function<void(Duration)>;
+        using TimePoint = typename Clock::time_point;
+        using Observer = Delegate<void(const TimerNotification&)>;
+        using ObserverId = std::uint32_t;
+
+        static constexpr std::size_t kMaxObservers = 4;
+        static constexpr ObserverId kInvalidObserver = 0;
+
+        // Plain copy of the timer's state, with the same queries as the timer
+        struct Snapshot {
+            TimerState state = TimerState::Stopped;
+            bool hasTarget = false;
+            TimePoint startTime{};
+            Duration totalElapsed{ 0 };
+            Duration target{ 0 };
+
+            Duration getElapsed(TimePoint now) const noexcept;
+            std::optional<Duration> getRemainingTime(TimePoint now) const noexcept;
+            float getProgressPercent(TimePoint now) const noexcept;
+        };
+        using Publisher = Seqlock<Snapshot>;
 
-        Timer();
-        ~Timer() = default;
+        BasicTimer();
+        ~BasicTimer() = default;
 
         // Core timer operations
-        void start();
-        void stop();
-        void pause();
+        void start() { start(Clock::now()); }
+        void stop() { stop(Clock::now()); }
+        void pause() { pause(Clock::now()); }
         void reset();
 
+        // Core timer operations at a caller-supplied instant
+        void start(TimePoint now);
+        void stop(TimePoint now);
+        void pause(TimePoint now);
+
         // State queries
         TimerState getState() const noexcept { return state_; }
         bool isRunning() const noexcept { return state_ == TimerState::Running; }
@@ -42,33 +103,316 @@ namespace LockedAndFlow {
         bool isStopped() const noexcept { return state_ == TimerState::Stopped; }
 
         // Time queries
-        Duration getElapsed() const;
+        Duration getElapsed() const { return getElapsed(Clock::now()); }
+        Duration getElapsed(TimePoint now) const;
         Duration getTotalElapsed() const noexcept { return totalElapsed_; }
 
         // Target duration support (for future Pomodoro-style sessions)
-        void setTargetDuration(Duration target) noexcept { targetDuration_ = target; }
+        void setTargetDuration(Duration target) noexcept { targetDuration_ = target; publish(); }
         std::optional<Duration> getTargetDuration() const noexcept { return targetDuration_; }
-        std::optional<Duration> getRemainingTime() const;
-        float getProgressPercent() const;
+        std::optional<Duration> getRemainingTime() const { return getRemainingTime(Clock::now()); }
+        std::optional<Duration> getRemainingTime(TimePoint now) const;
+        float getProgressPercent() const { return getProgressPercent(Clock::now()); }
+        float getProgressPercent(TimePoint now) const;
+
+        // Time until the shown value next changes on its own: the next whole elapsed
+        // second or the target expiring, whichever is sooner. Empty unless running.
+        std::optional<Duration> getTimeUntilNextTick(TimePoint now) const;
+
+        // Shared target arithmetic, so pooled and batched timers match Timer exactly
+        static Duration remainingFor(Duration elapsed, Duration target) noexcept {
+            return elapsed >= target ? Duration::zero() : target - elapsed;
+        }
+        static float progressPercentFor(Duration elapsed, Duration target) noexcept;
 
-        // Callback for real-time updates
-        void setUpdateCallback(TimerCallback callback) { updateCallback_ = std::move(callback); }
-        void update(); 
+        /**
+         * @brief Registers @p observer for the events in @p events
+         *
+         * Observers are stored inline (no allocation) and called synchronously
+         * on the owning thread. Tick fires once per new whole second rather
+         * than every update(), so observers need not track seconds themselves.
+         * Starting or resuming is not a new second: a run from 0 first ticks
+         * at 1s, one resumed at 3.5s at 4s.
+         * @return Id for unsubscribe(), or kInvalidObserver if all slots are taken
+         */
+        ObserverId subscribe(Observer observer, TimerEventMask events = kAllTimerEvents) noexcept;
+        ObserverId subscribe(Observer observer, TimerEvent event) noexcept {
+            return subscribe(observer, static_cast<TimerEventMask>(event));
+        }
+        void unsubscribe(ObserverId id) noexcept;
+
+        // Per-frame processing: Tick notifications and stopping at the target
+        void update() { update(Clock::now()); }
+        void update(TimePoint now);
 
         // Session persistence support
-        void saveElapsed(Duration elapsed) noexcept { totalElapsed_ = elapsed; }
+        void saveElapsed(Duration elapsed) noexcept { totalElapsed_ = elapsed; publish(); }
+
+        // Cross-thread reads. The publisher receives a snapshot now and after every
+        // mutation; it must outlive the attachment, and copies of the timer share it.
+        Snapshot getSnapshot() const noexcept;
+        void setPublisher(Publisher* publisher) noexcept { publisher_ = publisher; publish(); }
+        Publisher* getPublisher() const noexcept { return publisher_; }
 
     private:
         TimerState state_;
         TimePoint startTime_;
         Duration totalElapsed_;
         std::optional<Duration> targetDuration_;
-        TimerCallback updateCallback_;
+        Publisher* publisher_ = nullptr;
+
+        // Observers; a slot with an empty mask is free
+        struct Subscription {
+            Observer observer;
+            TimerEventMask events = 0;
+        };
+        std::array<Subscription, kMaxObservers> observers_{};
+        TimerEventMask subscribedEvents_ = 0;   // Union of all masks
+        std::int64_t lastTickSecond_ = 0;      // Last whole second of elapsed time seen by update()
 
         // Internal helper methods
-        void setState(TimerState newState);
-        Duration getCurrentElapsed() const;
-        void invokeCallback();
+        void setState(TimerState newState, TimePoint now);
+        Duration getCurrentElapsed(TimePoint now) const;
+        void notify(TimerEvent event, TimePoint now);
+        void publish() noexcept {
+            if (publisher_) {
+                publisher_->write(getSnapshot());
+            }
+        }
     };
 
-} // namespace LockedAndFlow
\ No newline at end of file
+    // The application timer; compiled once in Timer.cpp
+    using Timer = BasicTimer<>;
+
+    template <typename Clock>
+    BasicTimer<Clock>::BasicTimer()
+        : state_(TimerState::Stopped)
+        , startTime_()
+        , totalElapsed_(Duration::zero())
+        , targetDuration_() {
+    }
+
+    template <typename Clock>
+    void BasicTimer<Clock>::start(TimePoint now) {
+        if (state_ == TimerState::Running) {
+            return; // Already running
+        }
+
+        startTime_ = now;
+        lastTickSecond_ = totalElapsed_.count() / 1000;
+        setState(TimerState::Running, now);
+    }
+
+    template <typename Clock>
+    void BasicTimer<Clock>::stop(TimePoint now) {
+        if (state_ == TimerState::Stopped) {
+            return; // Already stopped
+        }
+
+        if (state_ == TimerState::Running) {
+            // Add current session time to total
+            totalElapsed_ += getCurrentElapsed(now);
+        }
+
+        setState(TimerState::Stopped, now);
+    }
+
+    template <typename Clock>
+    void BasicTimer<Clock>::pause(TimePoint now) {
+        if (state_ != TimerState::Running) {
+            return; // Can only pause if running
+        }
+
+        // Save current elapsed time
+        totalElapsed_ += getCurrentElapsed(now);
+        setState(TimerState::Paused, now);
+    }
+
+    template <typename Clock>
+    void BasicTimer<Clock>::reset() {
+        const bool wasStopped = state_ == TimerState::Stopped;
+        totalElapsed_ = Duration::zero();
+        lastTickSecond_ = 0;
+        setState(TimerState::Stopped, TimePoint()); // Stopped afterwards, so no clock sample is needed
+        if (wasStopped) {
+            publish(); // setState() only publishes a change of state
+        }
+    }
+
+    template <typename Clock>
+    typename BasicTimer<Clock>::Duration BasicTimer<Clock>::getElapsed(TimePoint now) const {
+        switch (state_) {
+        case TimerState::Running:
+            return totalElapsed_ + getCurrentElapsed(now);
+        case TimerState::Paused:
+        case TimerState::Stopped:
+            return totalElapsed_;
+        default:
+            return Duration::zero();
+        }
+    }
+
+    template <typename Clock>
+    std::optional<typename BasicTimer<Clock>::Duration> BasicTimer<Clock>::getRemainingTime(TimePoint now) const {
+        if (!targetDuration_.has_value()) {
+            return std::nullopt;
+        }
+
+        return remainingFor(getElapsed(now), targetDuration_.value());
+    }
+
+    template <typename Clock>
+    float BasicTimer<Clock>::getProgressPercent(TimePoint now) const {
+        if (!targetDuration_.has_value()) {
+            return 0.0f;
+        }
+
+        return progressPercentFor(getElapsed(now), targetDuration_.value());
+    }
+
+    template <typename Clock>
+    std::optional<typename BasicTimer<Clock>::Duration> BasicTimer<Clock>::getTimeUntilNextTick(TimePoint now) const {
+        if (state_ != TimerState::Running) {
+            return std::nullopt; // Nothing changes until the next input
+        }
+
+        // Elapsed is truncated to whole milliseconds, so this never lands before the boundary
+        const Duration elapsed = getElapsed(now);
+        Duration untilTick = Duration(1000 - elapsed.count() % 1000);
+        if (targetDuration_.has_value()) {
+            untilTick = std::min(untilTick, remainingFor(elapsed, targetDuration_.value()));
+        }
+        return untilTick;
+    }
+
+    template <typename Clock>
+    float BasicTimer<Clock>::progressPercentFor(Duration elapsed, Duration target) noexcept {
+        if (target.count() == 0) {
+            return 0.0f;
+        }
+
+        const float progress = static_cast<float>(elapsed.count()) /
+            static_cast<float>(target.count());
+
+        return std::clamp(progress * 100.0f, 0.0f, 100.0f);
+    }
+
+    template <typename Clock>
+    void BasicTimer<Clock>::update(TimePoint now) {
+        if (state_ != TimerState::Running) {
+            return;
+        }
+
+        const Duration elapsed = getElapsed(now);
+        if (subscribedEvents_ & static_cast<TimerEventMask>(TimerEvent::Tick)) {
+            const std::int64_t second = elapsed.count() / 1000;
+            if (second != lastTickSecond_) {
+                lastTickSecond_ = second;
+                notify(TimerEvent::Tick, now);
+            }
+        }
+
+        // Check if target duration reached
+        if (targetDuration_.has_value() && elapsed >= targetDuration_.value()) {
+            stop(now); // Automatically stop when target reached
+            notify(TimerEvent::TargetReached, now);
+        }
+    }
+
+    template <typename Clock>
+    void BasicTimer<Clock>::setState(TimerState newState, TimePoint now) {
+        if (state_ != newState) {
+            state_ = newState;
+            publish(); // Before observers run, so readers on other threads see the new state
+            notify(TimerEvent::StateChanged, now);
+        }
+    }
+
+    template <typename Clock>
+    typename BasicTimer<Clock>::Snapshot BasicTimer<Clock>::getSnapshot() const noexcept {
+        Snapshot snapshot;
+        snapshot.state = state_;
+        snapshot.hasTarget = targetDuration_.has_value();
+        snapshot.startTime = startTime_;
+        snapshot.totalElapsed = totalElapsed_;
+        snapshot.target = targetDuration_.value_or(Duration::zero());
+        return snapshot;
+    }
+
+    template <typename Clock>
+    typename BasicTimer<Clock>::Duration BasicTimer<Clock>::Snapshot::getElapsed(TimePoint now) const noexcept {
+        if (state != TimerState::Running) {
+            return totalElapsed;
+        }
+        return totalElapsed + std::chrono::duration_cast<Duration>(now - startTime);
+    }
+
+    template <typename Clock>
+    std::optional<typename BasicTimer<Clock>::Duration> BasicTimer<Clock>::Snapshot::getRemainingTime(TimePoint now) const noexcept {
+        if (!hasTarget) {
+            return std::nullopt;
+        }
+        return remainingFor(getElapsed(now), target);
+    }
+
+    template <typename Clock>
+    float BasicTimer<Clock>::Snapshot::getProgressPercent(TimePoint now) const noexcept {
+        return hasTarget ? progressPercentFor(getElapsed(now), target) : 0.0f;
+    }
+
+    template <typename Clock>
+    typename BasicTimer<Clock>::Duration BasicTimer<Clock>::getCurrentElapsed(TimePoint now) const {
+        if (state_ != TimerState::Running) {
+            return Duration::zero();
+        }
+
+        return std::chrono::duration_cast<Duration>(now - startTime_);
+    }
+
+    template <typename Clock>
+    typename BasicTimer<Clock>::ObserverId BasicTimer<Clock>::subscribe(Observer observer, TimerEventMask events) noexcept {
+        if (!observer || (events & kAllTimerEvents) == 0) {
+            return kInvalidObserver;
+        }
+
+        for (std::size_t i = 0; i < observers_.size(); ++i) {
+            if (observers_[i].events == 0) {
+                observers_[i] = { observer, static_cast<TimerEventMask>(events & kAllTimerEvents) };
+                subscribedEvents_ |= observers_[i].events;
+                return static_cast<ObserverId>(i + 1);
+            }
+        }
+        return kInvalidObserver;
+    }
+
+    template <typename Clock>
+    void BasicTimer<Clock>::unsubscribe(ObserverId id) noexcept {
+        if (id == kInvalidObserver || id > observers_.size()) {
+            return;
+        }
+
+        observers_[id - 1] = {};
+        subscribedEvents_ = 0;
+        for (const auto& subscription : observers_) {
+            subscribedEvents_ |= subscription.events;
+        }
+    }
+
+    template <typename Clock>
+    void BasicTimer<Clock>::notify(TimerEvent event, TimePoint now) {
+        const auto bit = static_cast<TimerEventMask>(event);
+        if ((subscribedEvents_ & bit) == 0) {
+            return;
+        }
+
+        const TimerNotification notification{ event, state_, getElapsed(now) };
+        for (const auto& subscription : observers_) {
+            if (subscription.events & bit) {
+                subscription.observer(notification);
+            }
+        }
+    }
+
+    extern template class BasicTimer<std::chrono::steady_clock>;
+
+} // namespace LockedAndFlow
@@ -0,0 +1,357 @@
+#include "TimerBatch.h"
+#include <cstring>
+#include <ratio>
+#include <type_traits>
+
+#if defined(__x86_64__) || defined(_M_X64)
+#define LAF_BATCH_X86_64 1
+#include <immintrin.h>
+#if defined(_MSC_VER) && !defined(__clang__)
+#include <intrin.h>
+#endif
+#endif
+
+#if defined(__GNUC__) || defined(__clang__)
+#define LAF_TARGET_AVX2 __attribute__((target("avx2")))
+#else
+#define LAF_TARGET_AVX2
+#endif
+
+namespace LockedAndFlow {
+
+    namespace {
+
+        using Duration = Timer::Duration;
+        using TimePoint = Timer::TimePoint;
+        using Tick = TimePoint::duration;
+
+        // The vector kernels convert clock ticks to milliseconds with an exact
+        // integer division, so they need a tick that divides a millisecond evenly
+        // (nanoseconds on every mainstream standard library)
+        using TicksPerMs = std::ratio_divide<Duration::period, Tick::period>;
+
+        constexpr bool kVectorizable =
+            TicksPerMs::den == 1 &&
+            sizeof(Tick) == 8 && std::is_signed_v<Tick::rep> &&
+            sizeof(Duration) == 8 && std::is_signed_v<Duration::rep> &&
+            sizeof(TimerState) == 4 &&
+            std::is_integral_v<Tick::rep> && std::is_integral_v<Duration::rep>;
+
+        constexpr std::int64_t kTicksPerMs = static_cast<std::int64_t>(TicksPerMs::num);
+
+        void evaluateScalar(const TimerBatchInput& input, TimePoint now, const TimerBatchOutput& output,
+            std::size_t begin, std::size_t end) {
+            for (std::size_t i = begin; i < end; ++i) {
+                Duration elapsed = input.totalElapsed[i];
+                if (input.states[i] == TimerState::Running) {
+                    elapsed += std::chrono::duration_cast<Duration>(now - input.startTimes[i]);
+                }
+
+                output.elapsed[i] = elapsed;
+                if (input.hasTarget[i]) {
+                    output.remaining[i] = Timer::remainingFor(elapsed, input.targets[i]);
+                    output.progressPercent[i] = Timer::progressPercentFor(elapsed, input.targets[i]);
+                }
+                else {
+                    output.remaining[i] = Duration::zero();
+                    output.progressPercent[i] = 0.0f;
+                }
+            }
+        }
+
+#if defined(LAF_BATCH_X86_64)
+
+        // Integers in [-2^51, 2^51) convert exactly to and from double by adding
+        // them to the mantissa of 1.5 * 2^52 ("magic number" conversion), which
+        // neither SSE2 nor AVX2 offer as an instruction
+        constexpr std::int64_t kMagicBits = 0x4338000000000000;
+        constexpr double kMagic = 6755399441055744.0; // 1.5 * 2^52
+        constexpr std::int64_t kRangeBias = std::int64_t{ 1 } << 51;
+
+        inline const std::int64_t* ticksOf(const TimePoint* points) {
+            return reinterpret_cast<const std::int64_t*>(points);
+        }
+
+        inline const std::int64_t* countsOf(const Duration* durations) {
+            return reinterpret_cast<const std::int64_t*>(durations);
+        }
+
+        inline std::int64_t* countsOf(Duration* durations) {
+            return reinterpret_cast<std::int64_t*>(durations);
+        }
+
+        // ---- SSE2: two timers per step -------------------------------------
+
+        inline __m128d toDouble(__m128i value) {
+            return _mm_sub_pd(_mm_castsi128_pd(_mm_add_epi64(value, _mm_set1_epi64x(kMagicBits))),
+                _mm_set1_pd(kMagic));
+        }
+
+        inline __m128i toInt64(__m128d integral) {
+            return _mm_sub_epi64(_mm_castpd_si128(_mm_add_pd(integral, _mm_set1_pd(kMagic))),
+                _mm_set1_epi64x(kMagicBits));
+        }
+
+        // Nonzero when any lane lies outside [-2^51, 2^51)
+        inline __m128i outOfRange(__m128i value) {
+            return _mm_srli_epi64(_mm_add_epi64(value, _mm_set1_epi64x(kRangeBias)), 52);
+        }
+
+        inline bool allZero(__m128i value) {
+            return _mm_movemask_epi8(_mm_cmpeq_epi32(value, _mm_setzero_si128())) == 0xFFFF;
+        }
+
+        // Truncating division by kTicksPerMs, matching duration_cast
+        inline __m128i ticksToMs(__m128i ticks) {
+            if constexpr (kTicksPerMs == 1) {
+                return ticks;
+            }
+
+            const __m128d divisor = _mm_set1_pd(static_cast<double>(kTicksPerMs));
+            const __m128d reciprocal = _mm_set1_pd(1.0 / static_cast<double>(kTicksPerMs));
+            const __m128d zero = _mm_setzero_pd();
+            const __m128d one = _mm_set1_pd(1.0);
+
+            const __m128d dividend = toDouble(ticks);
+            const __m128d quotient = _mm_mul_pd(dividend, reciprocal);
+            __m128d rounded = _mm_sub_pd(_mm_add_pd(quotient, _mm_set1_pd(kMagic)), _mm_set1_pd(kMagic));
+
+            // The reciprocal product is off by far less than one half, so rounding
+            // it to nearest lands at most one away from truncation; products are exact
+            const __m128d product = _mm_mul_pd(rounded, divisor);
+            const __m128d overshoot = _mm_and_pd(_mm_cmpgt_pd(product, dividend), _mm_cmpge_pd(dividend, zero));
+            const __m128d undershoot = _mm_and_pd(_mm_cmplt_pd(product, dividend), _mm_cmplt_pd(dividend, zero));
+            rounded = _mm_sub_pd(rounded, _mm_and_pd(overshoot, one));
+            rounded = _mm_add_pd(rounded, _mm_and_pd(undershoot, one));
+
+            return toInt64(rounded);
+        }
+
+        void evaluateSse2(const TimerBatchInput& input, TimePoint now, const TimerBatchOutput& output) {
+            const std::size_t vectorEnd = input.count & ~std::size_t{ 1 };
+            const __m128i nowTicks = _mm_set1_epi64x(now.time_since_epoch().count());
+            const __m128i runningState = _mm_set1_epi32(static_cast<int>(TimerState::Running));
+            const __m128i allOnes = _mm_set1_epi32(-1);
+            const __m128 zeroPs = _mm_setzero_ps();
+            const __m128 onePs = _mm_set1_ps(1.0f);
+            const __m128 hundred = _mm_set1_ps(100.0f);
+
+            for (std::size_t i = 0; i < vectorEnd; i += 2) {
+                // Widen two 32-bit state compares and two flag bytes to 64-bit lane masks
+                const __m128i stateMatch = _mm_cmpeq_epi32(
+                    _mm_loadl_epi64(reinterpret_cast<const __m128i*>(input.states + i)), runningState);
+                const __m128i running = _mm_unpacklo_epi32(stateMatch, stateMatch);
+
+                std::uint16_t targetFlags;
+                std::memcpy(&targetFlags, input.hasTarget + i, sizeof(targetFlags));
+                __m128i flags = _mm_cvtsi32_si128(targetFlags);
+                flags = _mm_unpacklo_epi8(flags, flags);
+                flags = _mm_unpacklo_epi16(flags, flags);
+                flags = _mm_unpacklo_epi32(flags, flags);
+                const __m128i hasTarget = _mm_xor_si128(_mm_cmpeq_epi8(flags, _mm_setzero_si128()), allOnes);
+
+                const __m128i start = _mm_loadu_si128(reinterpret_cast<const __m128i*>(ticksOf(input.startTimes) + i));
+                const __m128i total = _mm_loadu_si128(reinterpret_cast<const __m128i*>(countsOf(input.totalElapsed) + i));
+                const __m128i target = _mm_and_si128(hasTarget,
+                    _mm_loadu_si128(reinterpret_cast<const __m128i*>(countsOf(input.targets) + i)));
+                const __m128i delta = _mm_and_si128(running, _mm_sub_epi64(nowTicks, start));
+
+                if (!allZero(_mm_or_si128(_mm_or_si128(outOfRange(delta), outOfRange(total)), outOfRange(target)))) {
+                    evaluateScalar(input, now, output, i, i + 2);
+                    continue;
+                }
+
+                const __m128i elapsed = _mm_add_epi64(total, ticksToMs(delta));
+                if (!allZero(outOfRange(elapsed))) {
+                    evaluateScalar(input, now, output, i, i + 2);
+                    continue;
+                }
+                _mm_storeu_si128(reinterpret_cast<__m128i*>(countsOf(output.elapsed) + i), elapsed);
+
+                // remaining = elapsed >= target ? 0 : target - elapsed
+                const __m128i difference = _mm_sub_epi64(target, elapsed);
+                const __m128i negative = _mm_shuffle_epi32(_mm_srai_epi32(difference, 31), _MM_SHUFFLE(3, 3, 1, 1));
+                const __m128i remaining = _mm_and_si128(hasTarget, _mm_andnot_si128(negative, difference));
+                _mm_storeu_si128(reinterpret_cast<__m128i*>(countsOf(output.remaining) + i), remaining);
+
+                // progress = clamp(float(elapsed) / float(target) * 100, 0, 100) where target != 0
+                const __m128 elapsedPs = _mm_cvtpd_ps(toDouble(elapsed));
+                const __m128 targetPs = _mm_cvtpd_ps(toDouble(target));
+                const __m128 valid = _mm_cmpneq_ps(targetPs, zeroPs);
+                const __m128 divisor = _mm_or_ps(_mm_and_ps(valid, targetPs), _mm_andnot_ps(valid, onePs));
+                __m128 progress = _mm_mul_ps(_mm_div_ps(elapsedPs, divisor), hundred);
+                progress = _mm_min_ps(_mm_max_ps(progress, zeroPs), hundred);
+                progress = _mm_and_ps(valid, progress);
+                _mm_storel_pi(reinterpret_cast<__m64*>(output.progressPercent + i), progress);
+            }
+
+            evaluateScalar(input, now, output, vectorEnd, input.count);
+        }
+
+        // ---- AVX2: four timers per step ------------------------------------
+
+        LAF_TARGET_AVX2 inline __m256d toDouble256(__m256i value) {
+            return _mm256_sub_pd(_mm256_castsi256_pd(_mm256_add_epi64(value, _mm256_set1_epi64x(kMagicBits))),
+                _mm256_set1_pd(kMagic));
+        }
+
+        LAF_TARGET_AVX2 inline __m256i toInt64_256(__m256d integral) {
+            return _mm256_sub_epi64(_mm256_castpd_si256(_mm256_add_pd(integral, _mm256_set1_pd(kMagic))),
+                _mm256_set1_epi64x(kMagicBits));
+        }
+
+        LAF_TARGET_AVX2 inline __m256i outOfRange256(__m256i value) {
+            return _mm256_srli_epi64(_mm256_add_epi64(value, _mm256_set1_epi64x(kRangeBias)), 52);
+        }
+
+        LAF_TARGET_AVX2 inline __m256i ticksToMs256(__m256i ticks) {
+            if constexpr (kTicksPerMs == 1) {
+                return ticks;
+            }
+
+            const __m256d divisor = _mm256_set1_pd(static_cast<double>(kTicksPerMs));
+            const __m256d reciprocal = _mm256_set1_pd(1.0 / static_cast<double>(kTicksPerMs));
+            const __m256d zero = _mm256_setzero_pd();
+            const __m256d one = _mm256_set1_pd(1.0);
+
+            const __m256d dividend = toDouble256(ticks);
+            const __m256d quotient = _mm256_mul_pd(dividend, reciprocal);
+            __m256d rounded = _mm256_sub_pd(_mm256_add_pd(quotient, _mm256_set1_pd(kMagic)), _mm256_set1_pd(kMagic));
+
+            const __m256d product = _mm256_mul_pd(rounded, divisor);
+            const __m256d overshoot = _mm256_and_pd(_mm256_cmp_pd(product, dividend, _CMP_GT_OQ),
+                _mm256_cmp_pd(dividend, zero, _CMP_GE_OQ));
+            const __m256d undershoot = _mm256_and_pd(_mm256_cmp_pd(product, dividend, _CMP_LT_OQ),
+                _mm256_cmp_pd(dividend, zero, _CMP_LT_OQ));
+            rounded = _mm256_sub_pd(rounded, _mm256_and_pd(overshoot, one));
+            rounded = _mm256_add_pd(rounded, _mm256_and_pd(undershoot, one));
+
+            return toInt64_256(rounded);
+        }
+
+        LAF_TARGET_AVX2 void evaluateAvx2(const TimerBatchInput& input, TimePoint now, const TimerBatchOutput& output) {
+            const std::size_t vectorEnd = input.count & ~std::size_t{ 3 };
+            const __m256i nowTicks = _mm256_set1_epi64x(now.time_since_epoch().count());
+            const __m256i runningState = _mm256_set1_epi64x(static_cast<std::int64_t>(TimerState::Running));
+            const __m256i zero = _mm256_setzero_si256();
+            const __m128 zeroPs = _mm_setzero_ps();
+            const __m128 onePs = _mm_set1_ps(1.0f);
+            const __m128 hundred = _mm_set1_ps(100.0f);
+
+            for (std::size_t i = 0; i < vectorEnd; i += 4) {
+                const __m256i states = _mm256_cvtepi32_epi64(
+                    _mm_loadu_si128(reinterpret_cast<const __m128i*>(input.states + i)));
+                const __m256i running = _mm256_cmpeq_epi64(states, runningState);
+
+                std::int32_t targetFlags;
+                std::memcpy(&targetFlags, input.hasTarget + i, sizeof(targetFlags));
+                const __m256i hasTarget = _mm256_cmpgt_epi64(
+                    _mm256_cvtepu8_epi64(_mm_cvtsi32_si128(targetFlags)), zero);
+
+                const __m256i start = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(ticksOf(input.startTimes) + i));
+                const __m256i total = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(countsOf(input.totalElapsed) + i));
+                const __m256i target = _mm256_and_si256(hasTarget,
+                    _mm256_loadu_si256(reinterpret_cast<const __m256i*>(countsOf(input.targets) + i)));
+                const __m256i delta = _mm256_and_si256(running, _mm256_sub_epi64(nowTicks, start));
+
+                const __m256i inputRange = _mm256_or_si256(_mm256_or_si256(outOfRange256(delta), outOfRange256(total)),
+                    outOfRange256(target));
+                if (!_mm256_testz_si256(inputRange, inputRange)) {
+                    evaluateScalar(input, now, output, i, i + 4);
+                    continue;
+                }
+
+                const __m256i elapsed = _mm256_add_epi64(total, ticksToMs256(delta));
+                const __m256i elapsedRange = outOfRange256(elapsed);
+                if (!_mm256_testz_si256(elapsedRange, elapsedRange)) {
+                    evaluateScalar(input, now, output, i, i + 4);
+                    continue;
+                }
+                _mm256_storeu_si256(reinterpret_cast<__m256i*>(countsOf(output.elapsed) + i), elapsed);
+
+                const __m256i difference = _mm256_sub_epi64(target, elapsed);
+                const __m256i negative = _mm256_cmpgt_epi64(zero, difference);
+                const __m256i remaining = _mm256_and_si256(hasTarget, _mm256_andnot_si256(negative, difference));
+                _mm256_storeu_si256(reinterpret_cast<__m256i*>(countsOf(output.remaining) + i), remaining);
+
+                const __m128 elapsedPs = _mm256_cvtpd_ps(toDouble256(elapsed));
+                const __m128 targetPs = _mm256_cvtpd_ps(toDouble256(target));
+                const __m128 valid = _mm_cmpneq_ps(targetPs, zeroPs);
+                const __m128 divisor = _mm_blendv_ps(onePs, targetPs, valid);
+                __m128 progress = _mm_mul_ps(_mm_div_ps(elapsedPs, divisor), hundred);
+                progress = _mm_min_ps(_mm_max_ps(progress, zeroPs), hundred);
+                progress = _mm_and_ps(valid, progress);
+                _mm_storeu_ps(output.progressPercent + i, progress);
+            }
+
+            evaluateScalar(input, now, output, vectorEnd, input.count);
+        }
+
+        bool cpuSupportsAvx2() noexcept {
+#if defined(__GNUC__) || defined(__clang__)
+            return __builtin_cpu_supports("avx2");
+#elif defined(_MSC_VER)
+            int info[4];
+            __cpuid(info, 0);
+            if (info[0] < 7) {
+                return false;
+            }
+            __cpuid(info, 1);
+            const bool osSavesYmm = (info[2] & (1 << 27)) && ((_xgetbv(0) & 0x6) == 0x6);
+            __cpuidex(info, 7, 0);
+            return osSavesYmm && (info[1] & (1 << 5));
+#else
+            return false;
+#endif
+        }
+
+#endif // LAF_BATCH_X86_64
+
+    } // namespace
+
+    TimerBatchPath getBestTimerBatchPath() noexcept {
+#if defined(LAF_BATCH_X86_64)
+        if constexpr (kVectorizable) {
+            // Two-lane SSE2 measures slower than the scalar loop (bench/TimerBatchBench),
+            // so it is only used when asked for explicitly
+            static const bool hasAvx2 = cpuSupportsAvx2();
+            return hasAvx2 ? TimerBatchPath::Avx2 : TimerBatchPath::Scalar;
+        }
+#endif
+        return TimerBatchPath::Scalar;
+    }
+
+    const char* toString(TimerBatchPath path) noexcept {
+        switch (path) {
+        case TimerBatchPath::Auto:   return "Auto";
+        case TimerBatchPath::Scalar: return "Scalar";
+        case TimerBatchPath::Sse2:   return "SSE2";
+        case TimerBatchPath::Avx2:   return "AVX2";
+        default: return "Unknown";
+        }
+    }
+
+    void evaluateTimerBatch(const TimerBatchInput& input, Timer::TimePoint now,
+        const TimerBatchOutput& output, TimerBatchPath path) {
+        if (path == TimerBatchPath::Auto ||
+            (path == TimerBatchPath::Avx2 && getBestTimerBatchPath() != TimerBatchPath::Avx2)) {
+            path = getBestTimerBatchPath();
+        }
+
+#if defined(LAF_BATCH_X86_64)
+        // SSE2 is part of the x86-64 baseline, so it only depends on the tick type
+        if constexpr (kVectorizable) {
+            if (path == TimerBatchPath::Avx2) {
+                evaluateAvx2(input, now, output);
+                return;
+            }
+            if (path == TimerBatchPath::Sse2) {
+                evaluateSse2(input, now, output);
+                return;
+            }
+        }
+#endif
+        evaluateScalar(input, now, output, 0, input.count);
+    }
+
+} // namespace LockedAndFlow
@@ -0,0 +1,61 @@
+#pragma once
+
+#include "Timer.h"
+#include <cstddef>
+#include <cstdint>
+
+namespace LockedAndFlow {
+
+    /**
+     * @brief Structure-of-arrays view over many timers, e.g. TimerPool's slots
+     *
+     * All arrays hold `count` entries. `targets` is Duration::zero() and
+     * `hasTarget` is 0 for timers without a target.
+     */
+    struct TimerBatchInput {
+        const TimerState* states = nullptr;
+        const Timer::TimePoint* startTimes = nullptr;
+        const Timer::Duration* totalElapsed = nullptr;
+        const Timer::Duration* targets = nullptr;
+        const std::uint8_t* hasTarget = nullptr;
+        std::size_t count = 0;
+    };
+
+    /**
+     * @brief Caller-owned result arrays, each with room for `count` entries
+     *
+     * `remaining` is written as Duration::zero() for timers without a target,
+     * where Timer::getRemainingTime() would return std::nullopt.
+     */
+    struct TimerBatchOutput {
+        Timer::Duration* elapsed = nullptr;
+        Timer::Duration* remaining = nullptr;
+        float* progressPercent = nullptr;
+    };
+
+    enum class TimerBatchPath {
+        Auto,
+        Scalar,
+        Sse2,
+        Avx2
+    };
+
+    /**
+     * @brief Computes elapsed, remaining and progress percent for many timers
+     *
+     * Uses one `now` sample for the whole batch. Results are bit-identical to
+     * Timer::getElapsed(), getRemainingTime() and getProgressPercent() at the
+     * same instant. The vector paths handle four (AVX2) or two (SSE2) timers
+     * per step; blocks with values beyond 2^51 clock ticks fall back to scalar.
+     *
+     * @param path Kernel to use; Auto picks AVX2 when the CPU has it and the
+     *             scalar loop otherwise. Paths the CPU cannot run degrade to Auto.
+     */
+    void evaluateTimerBatch(const TimerBatchInput& input, Timer::TimePoint now,
+        const TimerBatchOutput& output, TimerBatchPath path = TimerBatchPath::Auto);
+
+    // Kernel that Auto resolves to on this machine
+    TimerBatchPath getBestTimerBatchPath() noexcept;
+    const char* toString(TimerBatchPath path) noexcept;
+
+} // namespace LockedAndFlow
@@ -0,0 +1,44 @@
+#include "TimerCommandQueue.h"
+
+namespace LockedAndFlow {
+
+    bool TimerCommandQueue::post(TimerCommandType type, Timer::Duration target) {
+        return post(TimerCommand{ type, target, Timer::ClockType::now() });
+    }
+
+    bool TimerCommandQueue::post(const TimerCommand& command) {
+        if (ring_.tryPush(command)) {
+            // acq_rel pairs with drain()'s re-arm, so a skipped notify means the
+            // pending drain is guaranteed to pop this command
+            if (!notified_.exchange(true, std::memory_order_acq_rel) && notifier_) {
+                notifier_();
+            }
+            return true;
+        }
+        dropped_.fetch_add(1, std::memory_order_relaxed);
+        return false;
+    }
+
+    bool TimerCommandQueue::apply(const TimerCommand& command, Timer& timer, Timer::TimePoint now) {
+        const TimerState before = timer.getState();
+        switch (command.type) {
+        case TimerCommandType::Start:
+            timer.start(now);
+            break;
+        case TimerCommandType::Pause:
+            timer.pause(now);
+            break;
+        case TimerCommandType::Stop:
+            timer.stop(now);
+            break;
+        case TimerCommandType::Reset:
+            timer.reset();
+            return true;
+        case TimerCommandType::SetTarget:
+            timer.setTargetDuration(command.target);
+            return true;
+        }
+        return timer.getState() != before;
+    }
+
+} // namespace LockedAndFlow
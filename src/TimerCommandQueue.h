@@ -0,0 +1,98 @@
+#pragma once
+
+#include "Delegate.h"
+#include "MpscRing.h"
+#include "Timer.h"
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+
+namespace LockedAndFlow {
+
+    enum class TimerCommandType : std::uint8_t {
+        Start,
+        Pause,
+        Stop,
+        Reset,
+        SetTarget
+    };
+
+    struct TimerCommand {
+        TimerCommandType type = TimerCommandType::Start;
+        Timer::Duration target{ 0 };   // SetTarget only
+        Timer::TimePoint issuedAt;     // For latency accounting; the owner applies at its own `now`
+    };
+
+    /**
+     * @brief Hands Timer operations from any thread to the thread that owns the Timer
+     *
+     * Hotkey, IPC and automation threads post() commands into a bounded
+     * lock-free ring; the owning thread drains it once per frame and applies
+     * them in order, so Timer itself stays single-threaded and the render path
+     * never takes a lock. A post() that finds the ring full is dropped and
+     * counted rather than blocking the producer.
+     *
+     * An owner that can block on something a producer can signal installs a
+     * notifier, which the first post() after each drain() calls. An owner that
+     * cannot be woken that way (a window event loop) instead caps its waits at
+     * kMaxLatency while getProducerCount() is non-zero; producers on other
+     * threads register for as long as they may post.
+     */
+    class TimerCommandQueue {
+    public:
+        static constexpr std::size_t kCapacity = 1024;
+        static constexpr std::chrono::milliseconds kMaxLatency{ 100 };
+
+        // Runs on the posting thread, so it must be thread-safe and quick (e.g. notify a condition variable)
+        using Notifier = Delegate<void()>;
+
+        // Owning thread, before any producer starts
+        void setNotifier(Notifier notifier) noexcept { notifier_ = notifier; }
+
+        // Any thread. @return false if the queue was full and the command was dropped
+        bool post(TimerCommandType type, Timer::Duration target = Timer::Duration::zero());
+        bool post(const TimerCommand& command);
+
+        // Off-thread producers, so that an owner without a notifier knows to poll
+        void registerProducer() noexcept { producers_.fetch_add(1, std::memory_order_relaxed); }
+        void unregisterProducer() noexcept { producers_.fetch_sub(1, std::memory_order_relaxed); }
+        std::uint32_t getProducerCount() const noexcept { return producers_.load(std::memory_order_relaxed); }
+
+        /**
+         * @brief Owning thread: pops every queued command and passes it to @p visitor
+         * @return Number of commands drained; kCapacity means more may be waiting
+         */
+        template <typename Visitor>
+        std::size_t drain(Visitor&& visitor) {
+            // Re-arm the notifier before popping: a post() that lands after this
+            // either is popped below or sees the flag clear and notifies
+            notified_.exchange(false, std::memory_order_acq_rel);
+
+            std::size_t drained = 0;
+            TimerCommand command;
+            while (drained < kCapacity && ring_.tryPop(command)) {
+                visitor(command);
+                ++drained;
+            }
+            return drained;
+        }
+
+        /**
+         * @brief Applies one command to @p timer at @p now
+         * @return true if it changed the timer (Reset and SetTarget always do)
+         */
+        static bool apply(const TimerCommand& command, Timer& timer, Timer::TimePoint now);
+
+        std::size_t getPendingApprox() const noexcept { return ring_.sizeApprox(); }
+        std::uint64_t getDroppedCount() const noexcept { return dropped_.load(std::memory_order_relaxed); }
+
+    private:
+        MpscRing<TimerCommand, kCapacity> ring_;
+        std::atomic<std::uint64_t> dropped_{ 0 };
+        std::atomic<bool> notified_{ false };       // Set by the first post() since the last drain()
+        std::atomic<std::uint32_t> producers_{ 0 };
+        Notifier notifier_;
+    };
+
+} // namespace LockedAndFlow
@@ -0,0 +1,157 @@
+#include "TimerDashboard.h"
+#include <algorithm>
+#include <cmath>
+
+namespace LockedAndFlow {
+
+    TimerDashboard::TimerDashboard(TimerPool& pool, sf::FloatRect area)
+        : pool_(pool)
+        , area_(area)
+        , cellSize_(TimerDisplay().getBounds().size + sf::Vector2f(kGap, kGap)) {
+    }
+
+    void TimerDashboard::setTimers(std::vector<TimerPool::Handle> timers) {
+        timers_ = std::move(timers);
+        for (auto& panel : panels_) {
+            panel.timerIndex = kNoTimer; // Re-assigned on the next update
+        }
+        scrollTo(scrollTarget_);
+    }
+
+    void TimerDashboard::addTimer(TimerPool::Handle timer) {
+        timers_.push_back(timer);
+    }
+
+    void TimerDashboard::setArea(sf::FloatRect area) {
+        const bool columnsChanged = std::floor(area.size.x / cellSize_.x) != std::floor(area_.size.x / cellSize_.x);
+        area_ = area;
+        if (columnsChanged) {
+            for (auto& panel : panels_) {
+                panel.timerIndex = kNoTimer;
+            }
+        }
+        scrollTo(scrollTarget_);
+    }
+
+    void TimerDashboard::scrollBy(float delta) noexcept {
+        scrollTo(scrollTarget_ + delta);
+    }
+
+    void TimerDashboard::scrollTo(float offset) noexcept {
+        scrollTarget_ = std::clamp(offset, 0.0f, getMaxScroll());
+    }
+
+    float TimerDashboard::getContentHeight() const noexcept {
+        const std::size_t columns = getColumnCount();
+        const std::size_t rows = (timers_.size() + columns - 1) / columns;
+        return static_cast<float>(rows) * cellSize_.y + kGap;
+    }
+
+    bool TimerDashboard::update(TimerPool::TimePoint now) {
+        // Off-screen timers only need their state advanced, which never touches SFML
+        pool_.updateAll(now);
+        bool changed = advanceScroll(now);
+
+        // Grid slots intersecting the visible area
+        const std::size_t columns = getColumnCount();
+        const auto firstRow = static_cast<std::size_t>(std::max(0.0f, (scroll_ - kGap) / cellSize_.y));
+        const auto lastRow = static_cast<std::size_t>(std::max(0.0f, (scroll_ + area_.size.y) / cellSize_.y)) + 1;
+        const std::size_t first = std::min(firstRow * columns, timers_.size());
+        const std::size_t last = std::min(lastRow * columns, timers_.size());
+
+        // Release panels that scrolled out, then hand them to timers that scrolled in
+        panelForRow_.assign(last - first, kNoTimer);
+        for (std::size_t i = 0; i < panels_.size(); ++i) {
+            Panel& panel = panels_[i];
+            if (panel.timerIndex >= first && panel.timerIndex < last) {
+                panelForRow_[panel.timerIndex - first] = i;
+            }
+            else {
+                panel.timerIndex = kNoTimer;
+            }
+        }
+
+        std::size_t nextFree = 0;
+        for (std::size_t slot = 0; slot < panelForRow_.size(); ++slot) {
+            if (panelForRow_[slot] != kNoTimer) {
+                continue;
+            }
+            while (nextFree < panels_.size() && panels_[nextFree].timerIndex != kNoTimer) {
+                ++nextFree;
+            }
+            if (nextFree == panels_.size()) {
+                panels_.push_back({ std::make_unique<TimerDisplay>(), kNoTimer });
+            }
+            Panel& panel = panels_[nextFree];
+            panel.timerIndex = first + slot;
+            panel.display->setPosition(getPanelPosition(panel.timerIndex));
+            panelForRow_[slot] = nextFree;
+            changed = true;
+        }
+
+        // Refresh and batch the panels that are actually on screen
+        const sf::FloatRect visible({ 0.0f, scroll_ }, area_.size);
+        batch_.clear();
+        for (const std::size_t panelIndex : panelForRow_) {
+            const Panel& panel = panels_[panelIndex];
+            if (!panel.display->getBounds().findIntersection(visible)) {
+                continue;
+            }
+
+            const TimerPool::Handle timer = timers_[panel.timerIndex];
+            std::optional<float> progress;
+            if (pool_.getTargetDuration(timer).has_value()) {
+                progress = pool_.getProgressPercent(timer, now);
+            }
+            changed = panel.display->updateFromValues(pool_.getState(timer), pool_.getElapsed(timer, now), progress) || changed;
+            batch_.add(*panel.display);
+        }
+        return changed;
+    }
+
+    void TimerDashboard::draw(sf::RenderTarget& target) const {
+        // Map the scrolled content rectangle onto the dashboard's screen area
+        const sf::Vector2f targetSize(target.getSize());
+        sf::View view(sf::FloatRect({ 0.0f, scroll_ }, area_.size));
+        view.setViewport(sf::FloatRect(
+            { area_.position.x / targetSize.x, area_.position.y / targetSize.y },
+            { area_.size.x / targetSize.x, area_.size.y / targetSize.y }));
+
+        const sf::View previous = target.getView();
+        target.setView(view);
+        batch_.draw(target);
+        target.setView(previous);
+    }
+
+    std::size_t TimerDashboard::getColumnCount() const noexcept {
+        return std::max<std::size_t>(1, static_cast<std::size_t>((area_.size.x - kGap) / cellSize_.x));
+    }
+
+    float TimerDashboard::getMaxScroll() const noexcept {
+        return std::max(0.0f, getContentHeight() - area_.size.y);
+    }
+
+    sf::Vector2f TimerDashboard::getPanelPosition(std::size_t timerIndex) const noexcept {
+        const std::size_t columns = getColumnCount();
+        return sf::Vector2f(
+            kGap + static_cast<float>(timerIndex % columns) * cellSize_.x,
+            kGap + static_cast<float>(timerIndex / columns) * cellSize_.y);
+    }
+
+    bool TimerDashboard::advanceScroll(TimerPool::TimePoint now) noexcept {
+        const float elapsed = lastUpdate_
+            ? std::chrono::duration<float>(now - *lastUpdate_).count()
+            : 0.0f;
+        lastUpdate_ = now;
+        if (scroll_ == scrollTarget_) {
+            return false;
+        }
+
+        // Exponential ease-out, frame-rate independent; snap once within half a pixel
+        const float remaining = scrollTarget_ - scroll_;
+        const float step = remaining * (1.0f - std::exp(-kScrollEasing * elapsed));
+        scroll_ = std::abs(remaining - step) < 0.5f ? scrollTarget_ : scroll_ + step;
+        return true;
+    }
+
+} // namespace LockedAndFlow
@@ -0,0 +1,82 @@
+#pragma once
+
+#include <SFML/Graphics.hpp>
+#include "TimerDisplay.h"
+#include "TimerDisplayBatch.h"
+#include "TimerPool.h"
+#include <cstddef>
+#include <memory>
+#include <optional>
+#include <vector>
+
+namespace LockedAndFlow {
+
+    /**
+     * @brief Scrollable grid of TimerDisplay panels over a TimerPool
+     *
+     * Only panels whose bounds intersect the visible area own a TimerDisplay;
+     * those are recycled as rows scroll in and out, so 10,000 timers cost about
+     * a screenful of SFML objects. Every timer's state is still advanced each
+     * update through TimerPool::updateAll(), which never touches SFML. Panels
+     * are laid out in content coordinates and the area is scrolled with an
+     * sf::View, so scrolling does not re-lay out the panels that stay visible.
+     * Visible panels are drawn through one TimerDisplayBatch.
+     */
+    class TimerDashboard {
+    public:
+        TimerDashboard(TimerPool& pool, sf::FloatRect area);
+
+        // Timers shown, in grid order (row-major)
+        void setTimers(std::vector<TimerPool::Handle> timers);
+        void addTimer(TimerPool::Handle timer);
+        std::size_t getTimerCount() const noexcept { return timers_.size(); }
+
+        // Screen area of the dashboard, in target pixels
+        void setArea(sf::FloatRect area);
+        sf::FloatRect getArea() const noexcept { return area_; }
+
+        // Smooth scrolling: scrollBy() moves the target, update() eases towards it
+        void scrollBy(float delta) noexcept;
+        void scrollTo(float offset) noexcept;
+        float getScroll() const noexcept { return scroll_; }
+        float getContentHeight() const noexcept;
+        bool isScrolling() const noexcept { return scroll_ != scrollTarget_; }
+
+        // Advance every timer, then refresh the visible panels; @return true if anything visible changed
+        bool update(TimerPool::TimePoint now);
+        void draw(sf::RenderTarget& target) const;
+
+        // Statistics for the last update
+        std::size_t getVisiblePanelCount() const noexcept { return batch_.getDisplayCount(); }
+        std::size_t getPanelCount() const noexcept { return panels_.size(); }
+        std::size_t getDrawCallCount() const noexcept { return batch_.getDrawCallCount(); }
+
+    private:
+        static constexpr std::size_t kNoTimer = static_cast<std::size_t>(-1);
+        static constexpr float kGap = 20.0f;
+        static constexpr float kScrollEasing = 12.0f; // Ease-out rate per second
+
+        struct Panel {
+            std::unique_ptr<TimerDisplay> display;
+            std::size_t timerIndex = kNoTimer;
+        };
+
+        TimerPool& pool_;
+        std::vector<TimerPool::Handle> timers_;
+        std::vector<Panel> panels_;
+        std::vector<std::size_t> panelForRow_; // Scratch: panel per visible grid slot
+        TimerDisplayBatch batch_;
+
+        sf::FloatRect area_;
+        sf::Vector2f cellSize_;
+        float scroll_ = 0.0f;
+        float scrollTarget_ = 0.0f;
+        std::optional<TimerPool::TimePoint> lastUpdate_;
+
+        std::size_t getColumnCount() const noexcept;
+        float getMaxScroll() const noexcept;
+        sf::Vector2f getPanelPosition(std::size_t timerIndex) const noexcept;
+        bool advanceScroll(TimerPool::TimePoint now) noexcept;
+    };
+
+} // namespace LockedAndFlow
@@ -1,22 +1,20 @@
 #include "TimerDisplay.h"
-#include <sstream>
-#include <iomanip>
+#include "DefaultFont.h"
+#include "DurationFormat.h"
 
 namespace LockedAndFlow {
 
     TimerDisplay::TimerDisplay(sf::Vector2f position)
-        : position_(position)
+        : timeReadout_(ClockGlyphAtlas::get(getDefaultFont(), 24))
+        , stateText_(getDefaultFont())       // SFML 3.0 requires font in constructor
+        , progressText_(getDefaultFont())    // SFML 3.0 requires font in constructor
+        , position_(position)
         , size_(sf::Vector2f(300.0f, 120.0f))
-        , padding_(20.0f)
-        , hasCustomFont_(false)
-        , timeText_(getDefaultFont())        // SFML 3.0 requires font in constructor
-        , stateText_(getDefaultFont())       // SFML 3.0 requires font in constructor  
-        , progressText_(getDefaultFont()) {  // SFML 3.0 requires font in constructor
+        , padding_(20.0f) {
 
-        // Configure time text
-        timeText_.setCharacterSize(24);
-        timeText_.setFillColor(sf::Color::White);
-        timeText_.setString("00:00:00");
+        // Configure time readout
+        timeReadout_.setFillColor(sf::Color::White);
+        timeReadout_.setText("00:00:00");
 
         // Configure state text
         stateText_.setCharacterSize(16);
@@ -53,85 +51,113 @@ namespace LockedAndFlow {
     }
 
     void TimerDisplay::setFont(const sf::Font& font) {
-        timeText_.setFont(font);
+        timeReadout_.setAtlas(ClockGlyphAtlas::get(font, timeReadout_.getAtlas().getCharacterSize()));
         stateText_.setFont(font);
         progressText_.setFont(font);
-        hasCustomFont_ = true;
         updateLayout();
     }
 
-    void TimerDisplay::setCharacterSize(unsigned int size) noexcept {
-        timeText_.setCharacterSize(size);
+    void TimerDisplay::setCharacterSize(unsigned int size) {
+        timeReadout_.setAtlas(ClockGlyphAtlas::get(timeReadout_.getAtlas().getFont(), size));
         stateText_.setCharacterSize(static_cast<unsigned int>(size * 0.67f));
         progressText_.setCharacterSize(static_cast<unsigned int>(size * 0.58f));
         updateLayout();
     }
 
-    void TimerDisplay::setTextColor(sf::Color color) noexcept {
-        timeText_.setFillColor(color);
+    void TimerDisplay::setTextColor(sf::Color color) {
+        timeReadout_.setFillColor(color);
     }
 
     void TimerDisplay::setBackgroundColor(sf::Color color) noexcept {
         background_.setFillColor(color);
+        ++layoutVersion_;
     }
 
-    void TimerDisplay::updateFromTimer(const Timer& timer) {
-        // Update time display
-        timeText_.setString(formatDuration(timer.getElapsed()));
-
-        // Update state display
-        stateText_.setString(stateToString(timer.getState()));
-
-        // Update state color based on timer state
-        switch (timer.getState()) {
-        case TimerState::Running:
-            stateText_.setFillColor(sf::Color::Green);
-            break;
-        case TimerState::Paused:
-            stateText_.setFillColor(sf::Color::Yellow);
-            break;
-        case TimerState::Stopped:
-            stateText_.setFillColor(sf::Color::Red);
-            break;
+    bool TimerDisplay::updateFromTimer(const Timer& timer) {
+        return updateFromTimer(timer, Timer::ClockType::now());
+    }
+
+    bool TimerDisplay::updateFromTimer(const Timer& timer, Timer::TimePoint now) {
+        std::optional<float> progress;
+        if (timer.getTargetDuration().has_value()) {
+            progress = timer.getProgressPercent(now);
+        }
+        return updateFromValues(timer.getState(), timer.getElapsed(now), progress);
+    }
+
+    bool TimerDisplay::updateFromValues(TimerState state, Timer::Duration elapsed, std::optional<float> progressPercent) {
+        const std::uint64_t rebuildsBefore = performedRebuilds_;
+
+        // Update time display only when the shown second changes
+        const std::int64_t second = elapsed.count() / 1000;
+        if (second != renderedSecond_) {
+            timeReadout_.setText(formatDuration(elapsed).view());
+            renderedSecond_ = second;
+            ++performedRebuilds_;
+        }
+        else {
+            ++skippedRebuilds_;
+        }
+
+        // Update state display and its color on state changes
+        if (state != renderedState_) {
+            stateText_.setString(stateToString(state));
+            switch (state) {
+            case TimerState::Running:
+                stateText_.setFillColor(sf::Color::Green);
+                break;
+            case TimerState::Paused:
+                stateText_.setFillColor(sf::Color::Yellow);
+                break;
+            case TimerState::Stopped:
+                stateText_.setFillColor(sf::Color::Red);
+                break;
+            }
+            renderedState_ = state;
+            ++performedRebuilds_;
+        }
+        else {
+            ++skippedRebuilds_;
         }
 
         // Update progress display if target duration is set
-        if (timer.getTargetDuration().has_value()) {
-            const float progress = timer.getProgressPercent();
-            progressText_.setString("Progress: " + std::to_string(static_cast<int>(progress)) + "%");
-            updateProgressBar(progress);
+        const bool hasTarget = progressPercent.has_value();
+        const float progress = progressPercent.value_or(0.0f);
+        const int percent = hasTarget ? static_cast<int>(progress) : kNoTarget;
+        if (percent != renderedPercent_) {
+            progressText_.setString(hasTarget
+                ? "Progress: " + std::to_string(percent) + "%"
+                : std::string("No target set"));
+            renderedPercent_ = percent;
+            ++performedRebuilds_;
         }
         else {
-            progressText_.setString("No target set");
-            updateProgressBar(0.0f);
+            ++skippedRebuilds_;
         }
+
+        updateProgressBar(progress);
+        return performedRebuilds_ != rebuildsBefore;
     }
 
     void TimerDisplay::draw(sf::RenderWindow& window) const {
-        window.draw(background_);
-        window.draw(progressBackground_);
-        window.draw(progressBar_);
-        window.draw(timeText_);
-        window.draw(stateText_);
-        window.draw(progressText_);
+        drawStatic(window);
+        drawDynamic(window);
     }
 
-    sf::FloatRect TimerDisplay::getBounds() const {
-        return sf::FloatRect{ position_, size_ };
+    void TimerDisplay::drawStatic(sf::RenderTarget& target) const {
+        target.draw(background_);
+        target.draw(progressBackground_);
     }
 
-    std::string TimerDisplay::formatDuration(Timer::Duration duration) const {
-        const auto totalSeconds = duration.count() / 1000;
-        const auto hours = totalSeconds / 3600;
-        const auto minutes = (totalSeconds % 3600) / 60;
-        const auto seconds = totalSeconds % 60;
-
-        std::ostringstream oss;
-        oss << std::setfill('0') << std::setw(2) << hours << ":"
-            << std::setfill('0') << std::setw(2) << minutes << ":"
-            << std::setfill('0') << std::setw(2) << seconds;
+    void TimerDisplay::drawDynamic(sf::RenderTarget& target) const {
+        target.draw(progressBar_);
+        target.draw(timeReadout_);
+        target.draw(stateText_);
+        target.draw(progressText_);
+    }
 
-        return oss.str();
+    sf::FloatRect TimerDisplay::getBounds() const {
+        return sf::FloatRect{ position_, size_ };
     }
 
     std::string TimerDisplay::stateToString(TimerState state) const {
@@ -144,16 +170,18 @@ namespace LockedAndFlow {
     }
 
     void TimerDisplay::updateLayout() {
+        ++layoutVersion_;
+
         // Position background
         background_.setPosition(position_);
 
-        // Position time text (centered horizontally, top area)
-        const auto timeBounds = timeText_.getLocalBounds();
+        // Position time readout (centered horizontally, top area)
+        const auto timeBounds = timeReadout_.getLocalBounds();
         sf::Vector2f timePosition(
             position_.x + (size_.x - timeBounds.size.x) / 2.0f,
             position_.y + padding_
         );
-        timeText_.setPosition(timePosition);
+        timeReadout_.setPosition(timePosition);
 
         // Position state text (left side, middle area)
         sf::Vector2f statePosition(
@@ -182,31 +210,26 @@ namespace LockedAndFlow {
         const float maxWidth = size_.x - (2.0f * padding_);
         const float currentWidth = (progressPercent / 100.0f) * maxWidth;
 
-        sf::Vector2f progressSize(currentWidth, 10.0f);
-        progressBar_.setSize(progressSize);
-
         // Change color based on progress
+        sf::Color color = sf::Color::Green;
         if (progressPercent >= 100.0f) {
-            progressBar_.setFillColor(sf::Color::Red);
+            color = sf::Color::Red;
         }
         else if (progressPercent >= 75.0f) {
-            progressBar_.setFillColor(sf::Color::Yellow);
-        }
-        else {
-            progressBar_.setFillColor(sf::Color::Green);
+            color = sf::Color::Yellow;
         }
-    }
-
-    sf::Font& TimerDisplay::getDefaultFont() {
-        static sf::Font defaultFont;
-        static bool initialized = false;
 
-        if (!initialized) {
-            // Try to load a system font, fallback to empty font if none available
-            initialized = true;
+        // The bar only looks different once it gains or loses a whole pixel
+        const int pixelWidth = static_cast<int>(currentWidth);
+        if (pixelWidth == renderedBarWidth_ && color == progressBar_.getFillColor()) {
+            ++skippedRebuilds_;
+            return;
         }
+        renderedBarWidth_ = pixelWidth;
+        ++performedRebuilds_;
 
-        return defaultFont;
+        progressBar_.setSize(sf::Vector2f(static_cast<float>(pixelWidth), 10.0f));
+        progressBar_.setFillColor(color);
     }
 
 } // namespace LockedAndFlow
\ No newline at end of file
@@ -1,7 +1,10 @@
 #pragma once
 
 #include <SFML/Graphics.hpp>
+#include "ClockReadout.h"
 #include "Timer.h"
+#include <cstdint>
+#include <optional>
 #include <string>
 #include <memory>
 
@@ -22,22 +25,38 @@ namespace LockedAndFlow {
         // Display configuration
         void setPosition(sf::Vector2f position) noexcept;
         void setFont(const sf::Font& font);
-        void setCharacterSize(unsigned int size) noexcept;
-        void setTextColor(sf::Color color) noexcept;
+        void setCharacterSize(unsigned int size);
+        void setTextColor(sf::Color color);
         void setBackgroundColor(sf::Color color) noexcept;
 
-        // Timer integration
-        void updateFromTimer(const Timer& timer);
+        // Timer integration; returns true if anything visible changed
+        bool updateFromTimer(const Timer& timer);
+        bool updateFromTimer(const Timer& timer, Timer::TimePoint now);
 
-        // Rendering
+        // Same as updateFromTimer() for timers that are not Timer objects (e.g. TimerPool
+        // slots); @p progressPercent is empty when the timer has no target
+        bool updateFromValues(TimerState state, Timer::Duration elapsed, std::optional<float> progressPercent);
+
+        // Rendering: draw() is drawStatic() then drawDynamic(). The static part
+        // (panel and progress track) only changes when getLayoutVersion() does
         void draw(sf::RenderWindow& window) const;
+        void drawStatic(sf::RenderTarget& target) const;
+        void drawDynamic(sf::RenderTarget& target) const;
+        std::uint64_t getLayoutVersion() const noexcept { return layoutVersion_; }
 
         // Layout properties
         sf::FloatRect getBounds() const;
 
+        // Rebuild statistics: each update touches up to four SFML objects (three
+        // texts and the progress bar) and skips those whose visible value is unchanged
+        std::uint64_t getPerformedRebuilds() const noexcept { return performedRebuilds_; }
+        std::uint64_t getSkippedRebuilds() const noexcept { return skippedRebuilds_; }
+
     private:
-        // Text rendering
-        sf::Text timeText_;
+        friend class TimerDisplayBatch; // Reads the laid-out shapes, texts and readout to batch them
+
+        // Text rendering; the clock uses prebaked digit glyphs
+        ClockReadout timeReadout_;
         sf::Text stateText_;
         sf::Text progressText_;
 
@@ -50,16 +69,22 @@ namespace LockedAndFlow {
         sf::Vector2f position_;
         sf::Vector2f size_;
         float padding_;
+        std::uint64_t layoutVersion_ = 0;
 
         // Helper methods
-        std::string formatDuration(Timer::Duration duration) const;
         std::string stateToString(TimerState state) const;
         void updateLayout();
         void updateProgressBar(float progressPercent);
 
-        // Default font handling
-        static sf::Font& getDefaultFont();
-        bool hasCustomFont_;
+        // Last values pushed into the SFML objects (sentinels until the first update)
+        static constexpr std::int64_t kNotRendered = -1;
+        static constexpr int kNoTarget = -2;
+        std::int64_t renderedSecond_ = kNotRendered;
+        std::optional<TimerState> renderedState_;
+        int renderedPercent_ = static_cast<int>(kNotRendered);
+        int renderedBarWidth_ = static_cast<int>(kNotRendered);
+        std::uint64_t performedRebuilds_ = 0;
+        std::uint64_t skippedRebuilds_ = 0;
     };
 
 } // namespace LockedAndFlow
\ No newline at end of file
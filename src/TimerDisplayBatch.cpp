@@ -0,0 +1,190 @@
+#include "TimerDisplayBatch.h"
+#include <cstdint>
+
+namespace LockedAndFlow {
+
+    namespace {
+
+        // Two triangles per quad; corners in the order top-left, top-right, bottom-left, bottom-right
+        void appendQuad(sf::VertexArray& vertices, const sf::Vertex (&corners)[4]) {
+            vertices.append(corners[0]);
+            vertices.append(corners[1]);
+            vertices.append(corners[2]);
+            vertices.append(corners[2]);
+            vertices.append(corners[1]);
+            vertices.append(corners[3]);
+        }
+
+    } // namespace
+
+    TimerDisplayBatch::TimerDisplayBatch()
+        : shapes_(sf::PrimitiveType::Triangles) {
+    }
+
+    void TimerDisplayBatch::clear() {
+        shapes_.clear();
+        for (auto& layer : textLayers_) {
+            layer.vertices.clear();
+        }
+        displayCount_ = 0;
+    }
+
+    void TimerDisplayBatch::add(const TimerDisplay& display) {
+        // Same order as TimerDisplay::draw() within each layer
+        appendShape(display.background_);
+        appendShape(display.progressBackground_);
+        appendShape(display.progressBar_);
+        appendReadout(display.timeReadout_);
+        appendText(display.stateText_);
+        appendText(display.progressText_);
+        ++displayCount_;
+    }
+
+    void TimerDisplayBatch::draw(sf::RenderTarget& target) const {
+        if (shapes_.getVertexCount() > 0) {
+            target.draw(shapes_);
+        }
+
+        for (const auto& layer : textLayers_) {
+            if (layer.vertices.getVertexCount() == 0) {
+                continue;
+            }
+            sf::RenderStates states;
+            states.texture = layer.texture;
+            target.draw(layer.vertices, states);
+        }
+    }
+
+    std::size_t TimerDisplayBatch::getDrawCallCount() const noexcept {
+        std::size_t calls = shapes_.getVertexCount() > 0 ? 1 : 0;
+        for (const auto& layer : textLayers_) {
+            calls += layer.vertices.getVertexCount() > 0 ? 1 : 0;
+        }
+        return calls;
+    }
+
+    std::size_t TimerDisplayBatch::getVertexCount() const noexcept {
+        std::size_t count = shapes_.getVertexCount();
+        for (const auto& layer : textLayers_) {
+            count += layer.vertices.getVertexCount();
+        }
+        return count;
+    }
+
+    void TimerDisplayBatch::appendShape(const sf::RectangleShape& shape) {
+        const sf::Transform& transform = shape.getTransform();
+        const sf::Vector2f size = shape.getSize();
+        appendRect(transform, sf::FloatRect({ 0.0f, 0.0f }, size), shape.getFillColor());
+
+        // Outline as four strips around the fill, like sf::Shape draws it (outside for positive thickness)
+        const float thickness = shape.getOutlineThickness();
+        if (thickness != 0.0f) {
+            const sf::Color color = shape.getOutlineColor();
+            const float outer = thickness > 0.0f ? thickness : 0.0f;
+            const float inner = thickness > 0.0f ? 0.0f : -thickness;
+            const float width = size.x + 2.0f * outer;
+            const float band = outer + inner;
+            appendRect(transform, sf::FloatRect({ -outer, -outer }, { width, band }), color);
+            appendRect(transform, sf::FloatRect({ -outer, size.y - inner }, { width, band }), color);
+            const float sideHeight = size.y - 2.0f * inner;
+            appendRect(transform, sf::FloatRect({ -outer, inner }, { band, sideHeight }), color);
+            appendRect(transform, sf::FloatRect({ size.x - inner, inner }, { band, sideHeight }), color);
+        }
+    }
+
+    void TimerDisplayBatch::appendRect(const sf::Transform& transform, sf::FloatRect rect, sf::Color color) {
+        const sf::Vector2f topLeft = rect.position;
+        const sf::Vector2f bottomRight = rect.position + rect.size;
+        appendQuad(shapes_, {
+            sf::Vertex{ transform.transformPoint(topLeft), color },
+            sf::Vertex{ transform.transformPoint({ bottomRight.x, topLeft.y }), color },
+            sf::Vertex{ transform.transformPoint({ topLeft.x, bottomRight.y }), color },
+            sf::Vertex{ transform.transformPoint(bottomRight), color } });
+    }
+
+    void TimerDisplayBatch::appendText(const sf::Text& text) {
+        const sf::String& string = text.getString();
+        if (string.isEmpty()) {
+            return;
+        }
+
+        const sf::Font& font = text.getFont();
+        const unsigned int characterSize = text.getCharacterSize();
+        const bool bold = (text.getStyle() & sf::Text::Bold) != 0;
+        const sf::Transform& transform = text.getTransform();
+        const sf::Color color = text.getFillColor();
+        sf::VertexArray& vertices = getTextVertices(font.getTexture(characterSize));
+
+        // Same glyph layout as sf::Text (no underline, strike-through or italic shear),
+        // including the 1 px it adds around each quad and texture rect: the font pads
+        // glyphs in its atlas, and this keeps their antialiased edges from being clipped
+        constexpr float kGlyphPadding = 1.0f;
+        float whitespaceWidth = font.getGlyph(U' ', characterSize, bold).advance;
+        const float letterSpacing = (whitespaceWidth / 3.0f) * (text.getLetterSpacing() - 1.0f);
+        whitespaceWidth += letterSpacing;
+        const float lineSpacing = font.getLineSpacing(characterSize) * text.getLineSpacing();
+
+        float x = 0.0f;
+        float y = static_cast<float>(characterSize);
+        std::uint32_t previous = 0;
+        for (const char32_t current : string) {
+            if (current == U'\r') {
+                continue;
+            }
+            x += font.getKerning(previous, current, characterSize, bold);
+            previous = current;
+
+            if (current == U' ' || current == U'\n' || current == U'\t') {
+                switch (current) {
+                case U' ':  x += whitespaceWidth; break;
+                case U'\t': x += whitespaceWidth * 4.0f; break;
+                default:    y += lineSpacing; x = 0.0f; break;
+                }
+                continue;
+            }
+
+            const sf::Glyph& glyph = font.getGlyph(current, characterSize, bold);
+            const sf::Vector2f padding(kGlyphPadding, kGlyphPadding);
+            const sf::Vector2f topLeft = sf::Vector2f(x, y) + glyph.bounds.position - padding;
+            const sf::Vector2f bottomRight = sf::Vector2f(x, y) + glyph.bounds.position + glyph.bounds.size + padding;
+            const sf::Vector2f uvTopLeft = sf::Vector2f(glyph.textureRect.position) - padding;
+            const sf::Vector2f uvBottomRight = sf::Vector2f(glyph.textureRect.position + glyph.textureRect.size) + padding;
+
+            appendQuad(vertices, {
+                sf::Vertex{ transform.transformPoint(topLeft), color, uvTopLeft },
+                sf::Vertex{ transform.transformPoint({ bottomRight.x, topLeft.y }), color, { uvBottomRight.x, uvTopLeft.y } },
+                sf::Vertex{ transform.transformPoint({ topLeft.x, bottomRight.y }), color, { uvTopLeft.x, uvBottomRight.y } },
+                sf::Vertex{ transform.transformPoint(bottomRight), color, uvBottomRight } });
+
+            x += glyph.advance + letterSpacing;
+        }
+    }
+
+    void TimerDisplayBatch::appendReadout(const ClockReadout& readout) {
+        if (readout.getVertexCount() == 0) {
+            return;
+        }
+
+        // The readout's quads are already laid out; only the transform is applied here
+        const sf::Transform& transform = readout.getTransform();
+        sf::VertexArray& vertices = getTextVertices(readout.getAtlas().getTexture());
+        const sf::Vertex* source = readout.getVertices();
+        for (std::size_t i = 0; i < readout.getVertexCount(); ++i) {
+            sf::Vertex vertex = source[i];
+            vertex.position = transform.transformPoint(vertex.position);
+            vertices.append(vertex);
+        }
+    }
+
+    // Font page textures keep their address as they grow, so layers can key on it
+    sf::VertexArray& TimerDisplayBatch::getTextVertices(const sf::Texture& texture) {
+        for (auto& layer : textLayers_) {
+            if (layer.texture == &texture) {
+                return layer.vertices;
+            }
+        }
+        textLayers_.push_back({ &texture, sf::VertexArray(sf::PrimitiveType::Triangles) });
+        return textLayers_.back().vertices;
+    }
+
+} // namespace LockedAndFlow
@@ -0,0 +1,53 @@
+#pragma once
+
+#include <SFML/Graphics.hpp>
+#include "TimerDisplay.h"
+#include <cstddef>
+#include <vector>
+
+namespace LockedAndFlow {
+
+    /**
+     * @brief Draws many TimerDisplays with a constant number of draw calls
+     *
+     * Every panel background, outline and progress bar goes into one untextured
+     * triangle list; every glyph goes into one triangle list per texture (the
+     * clock glyph atlas plus one per font and character size, three with the
+     * default layout). A grid of N displays therefore costs 1 + (distinct
+     * textures) draw calls instead of 6N. Shapes are drawn before all text, so overlapping displays layer
+     * differently than with TimerDisplay::draw(); grids do not overlap.
+     *
+     * Rebuild each frame with clear() / add() / draw(). Vertex storage is kept
+     * between frames, so a steady-state rebuild does not allocate.
+     */
+    class TimerDisplayBatch {
+    public:
+        TimerDisplayBatch();
+
+        void clear();
+        void add(const TimerDisplay& display);
+        void draw(sf::RenderTarget& target) const;
+
+        // Statistics for the last batch
+        std::size_t getDisplayCount() const noexcept { return displayCount_; }
+        std::size_t getDrawCallCount() const noexcept;
+        std::size_t getVertexCount() const noexcept;
+
+    private:
+        struct TextLayer {
+            const sf::Texture* texture;
+            sf::VertexArray vertices;
+        };
+
+        sf::VertexArray shapes_;
+        std::vector<TextLayer> textLayers_;
+        std::size_t displayCount_ = 0;
+
+        void appendShape(const sf::RectangleShape& shape);
+        void appendRect(const sf::Transform& transform, sf::FloatRect rect, sf::Color color);
+        void appendText(const sf::Text& text);
+        void appendReadout(const ClockReadout& readout);
+        sf::VertexArray& getTextVertices(const sf::Texture& texture);
+    };
+
+} // namespace LockedAndFlow
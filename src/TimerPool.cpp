@@ -0,0 +1,202 @@
+#include "TimerPool.h"
+
+namespace LockedAndFlow {
+
+    TimerPool::Handle TimerPool::create() {
+        if (!freeSlots_.empty()) {
+            const auto index = freeSlots_.back();
+            freeSlots_.pop_back();
+            return Handle{ index, generations_[index] };
+        }
+
+        const auto index = static_cast<std::uint32_t>(states_.size());
+        states_.push_back(TimerState::Stopped);
+        startTimes_.emplace_back();
+        totalElapsed_.push_back(Duration::zero());
+        targets_.push_back(Duration::zero());
+        hasTarget_.push_back(0);
+        generations_.push_back(0);
+
+        return Handle{ index, 0 };
+    }
+
+    void TimerPool::destroy(Handle handle) {
+        if (!isValid(handle)) {
+            return;
+        }
+
+        // Return the slot to the neutral state so bulk passes skip it
+        const auto index = handle.index;
+        states_[index] = TimerState::Stopped;
+        startTimes_[index] = TimePoint();
+        totalElapsed_[index] = Duration::zero();
+        targets_[index] = Duration::zero();
+        hasTarget_[index] = 0;
+        expiries_.cancel(index);
+
+        ++generations_[index]; // Invalidate outstanding handles
+        freeSlots_.push_back(index);
+    }
+
+    bool TimerPool::isValid(Handle handle) const noexcept {
+        return handle.index < generations_.size() && generations_[handle.index] == handle.generation;
+    }
+
+    void TimerPool::reserve(std::size_t capacity) {
+        states_.reserve(capacity);
+        startTimes_.reserve(capacity);
+        totalElapsed_.reserve(capacity);
+        targets_.reserve(capacity);
+        hasTarget_.reserve(capacity);
+        generations_.reserve(capacity);
+        expiries_.reserve(capacity);
+    }
+
+    void TimerPool::start(Handle handle, TimePoint now) {
+        if (!isValid(handle) || states_[handle.index] == TimerState::Running) {
+            return;
+        }
+
+        startTimes_[handle.index] = now;
+        states_[handle.index] = TimerState::Running;
+        scheduleExpiry(handle.index);
+    }
+
+    void TimerPool::stop(Handle handle, TimePoint now) {
+        if (!isValid(handle)) {
+            return;
+        }
+
+        stopAt(handle.index, now);
+    }
+
+    void TimerPool::pause(Handle handle, TimePoint now) {
+        if (!isValid(handle) || states_[handle.index] != TimerState::Running) {
+            return;
+        }
+
+        totalElapsed_[handle.index] += elapsedAt(handle.index, now);
+        states_[handle.index] = TimerState::Paused;
+        expiries_.cancel(handle.index);
+    }
+
+    void TimerPool::reset(Handle handle) {
+        if (!isValid(handle)) {
+            return;
+        }
+
+        totalElapsed_[handle.index] = Duration::zero();
+        states_[handle.index] = TimerState::Stopped;
+        expiries_.cancel(handle.index);
+    }
+
+    void TimerPool::setTargetDuration(Handle handle, Duration target) {
+        if (!isValid(handle)) {
+            return;
+        }
+
+        targets_[handle.index] = target;
+        hasTarget_[handle.index] = 1;
+        scheduleExpiry(handle.index);
+    }
+
+    void TimerPool::clearTargetDuration(Handle handle) {
+        if (!isValid(handle)) {
+            return;
+        }
+
+        targets_[handle.index] = Duration::zero();
+        hasTarget_[handle.index] = 0;
+        expiries_.cancel(handle.index);
+    }
+
+    TimerState TimerPool::getState(Handle handle) const noexcept {
+        return isValid(handle) ? states_[handle.index] : TimerState::Stopped;
+    }
+
+    TimerPool::Duration TimerPool::getElapsed(Handle handle, TimePoint now) const {
+        if (!isValid(handle)) {
+            return Duration::zero();
+        }
+
+        const auto index = handle.index;
+        if (states_[index] == TimerState::Running) {
+            return totalElapsed_[index] + elapsedAt(index, now);
+        }
+        return totalElapsed_[index];
+    }
+
+    std::optional<TimerPool::Duration> TimerPool::getTargetDuration(Handle handle) const {
+        if (!isValid(handle) || !hasTarget_[handle.index]) {
+            return std::nullopt;
+        }
+
+        return targets_[handle.index];
+    }
+
+    std::optional<TimerPool::Duration> TimerPool::getRemainingTime(Handle handle, TimePoint now) const {
+        if (!isValid(handle) || !hasTarget_[handle.index]) {
+            return std::nullopt;
+        }
+
+        return Timer::remainingFor(getElapsed(handle, now), targets_[handle.index]);
+    }
+
+    float TimerPool::getProgressPercent(Handle handle, TimePoint now) const {
+        if (!isValid(handle) || !hasTarget_[handle.index]) {
+            return 0.0f;
+        }
+
+        return Timer::progressPercentFor(getElapsed(handle, now), targets_[handle.index]);
+    }
+
+    std::size_t TimerPool::updateAll(TimePoint now, std::vector<Handle>* expired) {
+        dueScratch_.clear();
+        expiries_.advance(now, dueScratch_);
+
+        for (const std::uint32_t index : dueScratch_) {
+            stopAt(index, now); // Automatically stop when target reached
+            if (expired) {
+                expired->push_back(Handle{ index, generations_[index] });
+            }
+        }
+
+        return dueScratch_.size();
+    }
+
+    TimerBatchInput TimerPool::getBatchInput() const noexcept {
+        TimerBatchInput input;
+        input.states = states_.data();
+        input.startTimes = startTimes_.data();
+        input.totalElapsed = totalElapsed_.data();
+        input.targets = targets_.data();
+        input.hasTarget = hasTarget_.data();
+        input.count = states_.size();
+        return input;
+    }
+
+    TimerPool::Duration TimerPool::elapsedAt(std::uint32_t index, TimePoint now) const {
+        return std::chrono::duration_cast<Duration>(now - startTimes_[index]);
+    }
+
+    void TimerPool::stopAt(std::uint32_t index, TimePoint now) {
+        if (states_[index] == TimerState::Running) {
+            // Add current session time to total
+            totalElapsed_[index] += elapsedAt(index, now);
+        }
+
+        states_[index] = TimerState::Stopped;
+        expiries_.cancel(index);
+    }
+
+    void TimerPool::scheduleExpiry(std::uint32_t index) {
+        if (states_[index] != TimerState::Running || !hasTarget_[index]) {
+            expiries_.cancel(index);
+            return;
+        }
+
+        // The instant elapsed time reaches the target: Timer's `elapsed >= target` test
+        expiries_.schedule(index, startTimes_[index] + (targets_[index] - totalElapsed_[index]));
+    }
+
+} // namespace LockedAndFlow
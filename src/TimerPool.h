@@ -0,0 +1,116 @@
+#pragma once
+
+#include "Timer.h"
+#include "TimerBatch.h"
+#include "TimerWheel.h"
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <vector>
+
+namespace LockedAndFlow {
+
+    /**
+     * @brief Structure-of-arrays storage for large numbers of timers
+     *
+     * Keeps state, start time, accumulated elapsed time and target of every
+     * timer in separate contiguous arrays instead of a vector of Timer objects,
+     * so bulk passes touch only the fields they need. Timers are addressed by
+     * generation-checked handles that stay valid until the timer is destroyed.
+     * Pooled timers have no callbacks; all operations take an explicit `now`
+     * so a whole pass can share a single clock sample.
+     *
+     * Each running timer with a target has its expiry scheduled once in a
+     * TimerWheel (and rescheduled on pause/resume or a target change), so
+     * updateAll() costs O(expired timers) rather than a scan of the pool, and
+     * nextDeadline() tells an idle thread how long it may sleep.
+     */
+    class TimerPool {
+    public:
+        using Duration = Timer::Duration;
+        using TimePoint = Timer::TimePoint;
+
+        struct Handle {
+            std::uint32_t index = 0;
+            std::uint32_t generation = 0;
+
+            bool operator==(const Handle& other) const noexcept {
+                return index == other.index && generation == other.generation;
+            }
+            bool operator!=(const Handle& other) const noexcept { return !(*this == other); }
+        };
+
+        TimerPool() = default;
+
+        // Lifetime management
+        Handle create();
+        void destroy(Handle handle);
+        bool isValid(Handle handle) const noexcept;
+        void reserve(std::size_t capacity);
+
+        std::size_t size() const noexcept { return states_.size() - freeSlots_.size(); }
+        std::size_t slotCount() const noexcept { return states_.size(); }
+
+        // Core timer operations (no-ops on invalid handles, same rules as Timer)
+        void start(Handle handle, TimePoint now);
+        void stop(Handle handle, TimePoint now);
+        void pause(Handle handle, TimePoint now);
+        void reset(Handle handle);
+
+        // Target duration support
+        void setTargetDuration(Handle handle, Duration target);
+        void clearTargetDuration(Handle handle);
+
+        // Queries (defaults for invalid handles)
+        TimerState getState(Handle handle) const noexcept;
+        Duration getElapsed(Handle handle, TimePoint now) const;
+        std::optional<Duration> getTargetDuration(Handle handle) const;
+        std::optional<Duration> getRemainingTime(Handle handle, TimePoint now) const;
+        float getProgressPercent(Handle handle, TimePoint now) const;
+
+        /**
+         * @brief Stops every running timer whose target has been reached
+         *
+         * Pops due expiries from the timing wheel; timers that are not due are
+         * not touched. Handles of the timers that expired are appended to
+         * @p expired if given, in expiry order.
+         * @return Number of timers stopped by this call
+         */
+        std::size_t updateAll(TimePoint now, std::vector<Handle>* expired = nullptr);
+
+        // When the next running timer reaches its target; empty if none will
+        std::optional<TimePoint> nextDeadline() const noexcept { return expiries_.nextDeadline(); }
+
+        // Raw per-slot arrays (length slotCount()) for batch evaluation.
+        // Free slots are Stopped with no target.
+        const TimerState* stateData() const noexcept { return states_.data(); }
+        const TimePoint* startTimeData() const noexcept { return startTimes_.data(); }
+        const Duration* totalElapsedData() const noexcept { return totalElapsed_.data(); }
+        const Duration* targetData() const noexcept { return targets_.data(); }
+        const std::uint8_t* hasTargetData() const noexcept { return hasTarget_.data(); }
+
+        // All slots as one batch for evaluateTimerBatch()
+        TimerBatchInput getBatchInput() const noexcept;
+
+    private:
+        // Hot per-slot arrays, indexed by Handle::index
+        std::vector<TimerState> states_;
+        std::vector<TimePoint> startTimes_;
+        std::vector<Duration> totalElapsed_;
+        std::vector<Duration> targets_;       // Duration::zero() when unset
+        std::vector<std::uint8_t> hasTarget_;
+
+        // Handle bookkeeping
+        std::vector<std::uint32_t> generations_;
+        std::vector<std::uint32_t> freeSlots_;
+
+        // Target expiries of running timers, keyed by slot index
+        TimerWheel expiries_;
+        std::vector<TimerWheel::Key> dueScratch_;
+
+        Duration elapsedAt(std::uint32_t index, TimePoint now) const;
+        void stopAt(std::uint32_t index, TimePoint now);
+        void scheduleExpiry(std::uint32_t index);
+    };
+
+} // namespace LockedAndFlow
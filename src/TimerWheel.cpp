@@ -0,0 +1,246 @@
+#include "TimerWheel.h"
+
+#if defined(_MSC_VER) && !defined(__clang__)
+#include <intrin.h>
+#endif
+
+namespace LockedAndFlow {
+
+    namespace {
+
+        unsigned highestBit(std::uint64_t value) noexcept {
+#if defined(_MSC_VER) && !defined(__clang__)
+            unsigned long index;
+            _BitScanReverse64(&index, value);
+            return static_cast<unsigned>(index);
+#else
+            return 63u - static_cast<unsigned>(__builtin_clzll(value));
+#endif
+        }
+
+        unsigned lowestBit(std::uint64_t value) noexcept {
+#if defined(_MSC_VER) && !defined(__clang__)
+            unsigned long index;
+            _BitScanForward64(&index, value);
+            return static_cast<unsigned>(index);
+#else
+            return static_cast<unsigned>(__builtin_ctzll(value));
+#endif
+        }
+
+    } // namespace
+
+    TimerWheel::TimerWheel() {
+        heads_.fill(kNil);
+        tails_.fill(kNil);
+    }
+
+    void TimerWheel::schedule(Key key, TimePoint deadline) {
+        if (key >= nodes_.size()) {
+            nodes_.resize(static_cast<std::size_t>(key) + 1);
+        }
+        if (nodes_[key].bucket != kNoBucket) {
+            unlink(key);
+            --size_;
+        }
+
+        nodes_[key].deadline = deadline;
+        nodes_[key].tick = tickOf(deadline);
+        insert(key);
+        ++size_;
+    }
+
+    void TimerWheel::cancel(Key key) noexcept {
+        if (!isScheduled(key)) {
+            return;
+        }
+        unlink(key);
+        --size_;
+    }
+
+    bool TimerWheel::isScheduled(Key key) const noexcept {
+        return key < nodes_.size() && nodes_[key].bucket != kNoBucket;
+    }
+
+    std::optional<TimerWheel::TimePoint> TimerWheel::getDeadline(Key key) const noexcept {
+        if (!isScheduled(key)) {
+            return std::nullopt;
+        }
+        return nodes_[key].deadline;
+    }
+
+    std::size_t TimerWheel::advance(TimePoint now, std::vector<Key>& expired) {
+        const std::uint64_t target = tickOf(now);
+
+        // Visit non-empty slots in time order: level 0 slots hand their entries to
+        // the due list, higher slots (and the overflow list) cascade one level down
+        for (auto event = nextEvent(); event && event->tick <= target; event = nextEvent()) {
+            current_ = event->tick;
+
+            // Detach the whole list first: overflow entries still out of range go
+            // back onto the same list, which must not be walked again
+            std::uint32_t key = heads_[event->bucket];
+            heads_[event->bucket] = kNil;
+            tails_[event->bucket] = kNil;
+            if (event->bucket < kDueBucket) {
+                occupied_[event->bucket / kSlots] &= ~(std::uint64_t(1) << (event->bucket % kSlots));
+            }
+            while (key != kNil) {
+                const std::uint32_t next = nodes_[key].next;
+                insert(key);
+                key = next;
+            }
+        }
+        if (target > current_) {
+            current_ = target;
+        }
+
+        // Entries of the current millisecond may still lie a fraction of it ahead of `now`
+        const std::size_t before = expired.size();
+        std::uint32_t key = heads_[kDueBucket];
+        while (key != kNil) {
+            const std::uint32_t next = nodes_[key].next;
+            if (nodes_[key].deadline <= now) {
+                unlink(key);
+                --size_;
+                expired.push_back(key);
+            }
+            key = next;
+        }
+
+        // Slots were emptied in time order and lists append at the tail, so the
+        // due list is already ordered by millisecond; an insertion sort only has
+        // to settle deadlines within one millisecond (and late schedules)
+        for (std::size_t i = before + 1; i < expired.size(); ++i) {
+            const Key moving = expired[i];
+            std::size_t j = i;
+            for (; j > before && nodes_[moving].deadline < nodes_[expired[j - 1]].deadline; --j) {
+                expired[j] = expired[j - 1];
+            }
+            expired[j] = moving;
+        }
+        return expired.size() - before;
+    }
+
+    std::optional<TimerWheel::TimePoint> TimerWheel::nextDeadline() const noexcept {
+        // Slot ranges are disjoint and ordered, so the earliest deadline is in the
+        // due list if it has entries, otherwise in the next slot to be reached
+        std::uint16_t bucket = kDueBucket;
+        if (heads_[kDueBucket] == kNil) {
+            const auto event = nextEvent();
+            if (!event) {
+                return std::nullopt;
+            }
+            bucket = event->bucket;
+        }
+
+        std::optional<TimePoint> earliest;
+        for (std::uint32_t key = heads_[bucket]; key != kNil; key = nodes_[key].next) {
+            if (!earliest || nodes_[key].deadline < *earliest) {
+                earliest = nodes_[key].deadline;
+            }
+        }
+        return earliest;
+    }
+
+    void TimerWheel::clear() noexcept {
+        for (auto& node : nodes_) {
+            node = Node{};
+        }
+        heads_.fill(kNil);
+        tails_.fill(kNil);
+        occupied_.fill(0);
+        size_ = 0;
+    }
+
+    std::uint64_t TimerWheel::tickOf(TimePoint time) noexcept {
+        const auto ticks = std::chrono::duration_cast<Duration>(time.time_since_epoch()).count();
+        return ticks > 0 ? static_cast<std::uint64_t>(ticks) : 0;
+    }
+
+    void TimerWheel::insert(Key key) noexcept {
+        const std::uint64_t tick = nodes_[key].tick;
+        if (tick <= current_) {
+            link(key, kDueBucket);
+            return;
+        }
+
+        // Highest 6-bit digit in which the deadline differs from the current tick
+        const unsigned level = highestBit(tick ^ current_) / kLevelBits;
+        if (level >= kLevels) {
+            link(key, kOverflowBucket);
+            return;
+        }
+
+        const auto slot = static_cast<unsigned>((tick >> (level * kLevelBits)) & (kSlots - 1));
+        link(key, static_cast<std::uint16_t>(level * kSlots + slot));
+        occupied_[level] |= std::uint64_t(1) << slot;
+    }
+
+    void TimerWheel::link(Key key, std::uint16_t bucket) noexcept {
+        Node& node = nodes_[key];
+        node.bucket = bucket;
+        node.prev = tails_[bucket];
+        node.next = kNil;
+        if (node.prev != kNil) {
+            nodes_[node.prev].next = key;
+        }
+        else {
+            heads_[bucket] = key;
+        }
+        tails_[bucket] = key;
+    }
+
+    void TimerWheel::unlink(Key key) noexcept {
+        Node& node = nodes_[key];
+        if (node.prev != kNil) {
+            nodes_[node.prev].next = node.next;
+        }
+        else {
+            heads_[node.bucket] = node.next;
+        }
+        if (node.next != kNil) {
+            nodes_[node.next].prev = node.prev;
+        }
+        else {
+            tails_[node.bucket] = node.prev;
+        }
+
+        if (node.bucket < kDueBucket && heads_[node.bucket] == kNil) {
+            occupied_[node.bucket / kSlots] &= ~(std::uint64_t(1) << (node.bucket % kSlots));
+        }
+        node.prev = kNil;
+        node.next = kNil;
+        node.bucket = kNoBucket;
+    }
+
+    std::optional<TimerWheel::Event> TimerWheel::nextEvent() const noexcept {
+        std::optional<Event> earliest;
+        for (std::size_t level = 0; level < kLevels; ++level) {
+            const unsigned shift = static_cast<unsigned>(level * kLevelBits);
+            const auto digit = static_cast<unsigned>((current_ >> shift) & (kSlots - 1));
+            const std::uint64_t ahead = occupied_[level] & ~((std::uint64_t(2) << digit) - 1);
+            if (ahead == 0) {
+                continue;
+            }
+
+            // Start of the slot: current tick's higher digits, this slot's digit, zeros below
+            const unsigned slot = lowestBit(ahead);
+            const unsigned groupShift = shift + kLevelBits;
+            const std::uint64_t tick = ((current_ >> groupShift) << groupShift) | (std::uint64_t(slot) << shift);
+            if (!earliest || tick < earliest->tick) {
+                earliest = Event{ tick, static_cast<std::uint16_t>(level * kSlots + slot) };
+            }
+        }
+
+        if (heads_[kOverflowBucket] != kNil) {
+            constexpr unsigned kRangeBits = kLevels * kLevelBits;
+            const std::uint64_t tick = ((current_ >> kRangeBits) + 1) << kRangeBits;
+            if (!earliest || tick < earliest->tick) {
+                earliest = Event{ tick, kOverflowBucket };
+            }
+        }
+        return earliest;
+    }
+
+} // namespace LockedAndFlow
@@ -0,0 +1,95 @@
+#pragma once
+
+#include "Timer.h"
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <vector>
+
+namespace LockedAndFlow {
+
+    /**
+     * @brief Hierarchical timing wheel of one-shot deadlines
+     *
+     * Six levels of 64 slots at 1 ms resolution (about 2.2 years of range,
+     * with an overflow list beyond that). Each entry sits in the slot of the
+     * highest 6-bit digit where its deadline differs from the wheel's current
+     * tick and moves one level down each time the wheel reaches that slot, so
+     * an entry is touched at most once per level before it fires: schedule,
+     * cancel and expiry are O(1) amortized. Per-level occupancy bitmasks let
+     * advance() jump straight to the next non-empty slot instead of stepping
+     * through empty milliseconds, and nextDeadline() tells an idle thread how
+     * long it may sleep.
+     *
+     * Entries are identified by small dense keys (e.g. TimerPool slot indices)
+     * and stored intrusively, so rescheduling a key never allocates once its
+     * node exists. Deadlines are kept exactly; nothing fires before its deadline.
+     */
+    class TimerWheel {
+    public:
+        using TimePoint = Timer::TimePoint;
+        using Duration = Timer::Duration;
+        using Key = std::uint32_t;
+
+        static constexpr unsigned kLevelBits = 6;
+        static constexpr std::size_t kSlots = std::size_t(1) << kLevelBits;
+        static constexpr std::size_t kLevels = 6;
+
+        TimerWheel();
+
+        // Replaces any deadline already scheduled for @p key
+        void schedule(Key key, TimePoint deadline);
+        void cancel(Key key) noexcept;
+        bool isScheduled(Key key) const noexcept;
+        std::optional<TimePoint> getDeadline(Key key) const noexcept;
+
+        /**
+         * @brief Removes every entry whose deadline is at or before @p now
+         * @return Number of keys appended to @p expired, in deadline order
+         */
+        std::size_t advance(TimePoint now, std::vector<Key>& expired);
+
+        // Earliest scheduled deadline; empty if nothing is scheduled
+        std::optional<TimePoint> nextDeadline() const noexcept;
+
+        void reserve(std::size_t keys) { nodes_.reserve(keys); }
+        std::size_t size() const noexcept { return size_; }
+        bool empty() const noexcept { return size_ == 0; }
+        void clear() noexcept;
+
+    private:
+        static constexpr std::uint32_t kNil = UINT32_MAX;
+        static constexpr std::uint16_t kNoBucket = UINT16_MAX;
+        static constexpr std::uint16_t kDueBucket = kLevels * kSlots;      // Tick already reached
+        static constexpr std::uint16_t kOverflowBucket = kDueBucket + 1;   // Beyond the top level
+        static constexpr std::size_t kBucketCount = kOverflowBucket + 1;
+
+        struct Node {
+            TimePoint deadline;
+            std::uint64_t tick = 0;
+            std::uint32_t prev = kNil;
+            std::uint32_t next = kNil;
+            std::uint16_t bucket = kNoBucket;
+        };
+
+        struct Event {
+            std::uint64_t tick;
+            std::uint16_t bucket;
+        };
+
+        std::vector<Node> nodes_;                       // Indexed by key
+        std::array<std::uint32_t, kBucketCount> heads_;
+        std::array<std::uint32_t, kBucketCount> tails_; // Lists append, keeping slot order
+        std::array<std::uint64_t, kLevels> occupied_{}; // Bit per non-empty slot
+        std::uint64_t current_ = 0;                     // Ticks (ms) since the clock's epoch
+        std::size_t size_ = 0;
+
+        static std::uint64_t tickOf(TimePoint time) noexcept;
+        void insert(Key key) noexcept;
+        void link(Key key, std::uint16_t bucket) noexcept;
+        void unlink(Key key) noexcept;
+        std::optional<Event> nextEvent() const noexcept;
+    };
+
+} // namespace LockedAndFlow
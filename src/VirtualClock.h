@@ -0,0 +1,35 @@
+#pragma once
+
+#include <chrono>
+
+namespace LockedAndFlow {
+
+    /**
+     * @brief Manually advanced clock for simulations and deterministic replays
+     *
+     * Meets the std::chrono clock requirements, so BasicTimer<VirtualClock>
+     * reads it wherever Timer would read steady_clock. Its time_point is
+     * steady_clock's, so virtual instants can be passed straight to TimerPool,
+     * TimerWheel and evaluateTimerBatch, which take Timer::TimePoint.
+     *
+     * The current time is process-wide and not synchronised: drive it from
+     * one thread. It starts at the steady_clock epoch and must only move
+     * forward (is_steady).
+     */
+    struct VirtualClock {
+        using duration = std::chrono::steady_clock::duration;
+        using rep = duration::rep;
+        using period = duration::period;
+        using time_point = std::chrono::steady_clock::time_point;
+        static constexpr bool is_steady = true;
+
+        static time_point now() noexcept { return current_; }
+
+        static void set(time_point now) noexcept { current_ = now; }
+        static void advance(duration step) noexcept { current_ += step; }
+
+    private:
+        static inline time_point current_{};
+    };
+
+} // namespace LockedAndFlow
@@ -0,0 +1,366 @@
+#include <algorithm>
+#include <cerrno>
+#include <chrono>
+#include <csignal>
+#include <cstdlib>
+#include <cstring>
+#include <optional>
+#include <string>
+#include <unordered_map>
+#include <vector>
+#include <sys/epoll.h>
+#include <sys/signalfd.h>
+#include <sys/socket.h>
+#include <sys/stat.h>
+#include <sys/un.h>
+#include <unistd.h>
+#include "ControlProtocol.h"
+#include "Logger.h"
+#include "TimerPool.h"
+
+// Headless timer daemon: owns a pool of named timers and serves the
+// ControlProtocol line protocol on a Unix domain socket, e.g.
+//   printf 'start build\nquery build\n' | socat - UNIX-CONNECT:$XDG_RUNTIME_DIR/lockedandflow.sock
+// One thread, one epoll set: the listener, a signalfd for SIGINT/SIGTERM and
+// every client. Between requests it sleeps in epoll_wait() until the pool's
+// next target deadline, so an idle daemon with running timers never polls.
+
+namespace {
+
+    constexpr int kMaxEventsPerWait = 64;
+    constexpr std::size_t kReadChunk = 64 * 1024;
+    constexpr std::size_t kMaxPendingReplies = 1024 * 1024; // Stop reading a client that doesn't read its replies
+
+    struct Connection {
+        std::string input;
+        std::string replies;
+        bool closing = false;   // Peer finished sending or broke the protocol; drain replies, then close
+        std::uint32_t interest = EPOLLIN | EPOLLRDHUP;
+    };
+
+    std::string defaultSocketPath() {
+        if (const char* runtimeDir = std::getenv("XDG_RUNTIME_DIR")) {
+            return std::string(runtimeDir) + "/lockedandflow.sock";
+        }
+        return "/tmp/lockedandflow-" + std::to_string(::getuid()) + ".sock";
+    }
+
+    void reportError(const char* what) {
+        LAF_LOG_ERROR("{}: {}", what, std::strerror(errno));
+    }
+
+    // Removes a socket left behind by a daemon that is gone. Anything else at
+    // @p path (a regular file, a live daemon's socket) is left alone.
+    bool removeStaleSocket(const std::string& path, const sockaddr_un& address) {
+        struct stat status{};
+        if (::lstat(path.c_str(), &status) != 0) {
+            if (errno == ENOENT) {
+                return true;
+            }
+            reportError("lstat");
+            return false;
+        }
+        if (!S_ISSOCK(status.st_mode)) {
+            LAF_LOG_ERROR("{} exists and is not a socket", path);
+            return false;
+        }
+
+        // Only a refused connection proves nobody is listening
+        const int probe = ::socket(AF_UNIX, SOCK_STREAM | SOCK_NONBLOCK | SOCK_CLOEXEC, 0);
+        if (probe < 0) {
+            reportError("socket");
+            return false;
+        }
+        const bool refused = ::connect(probe, reinterpret_cast<const sockaddr*>(&address), sizeof(address)) != 0 &&
+            errno == ECONNREFUSED;
+        ::close(probe);
+        if (!refused) {
+            LAF_LOG_ERROR("Already running: another daemon is listening on {}", path);
+            return false;
+        }
+        return ::unlink(path.c_str()) == 0 || errno == ENOENT;
+    }
+
+    // Listening socket bound at @p path; @p bound receives the socket file's identity
+    int openListener(const std::string& path, struct stat& bound) {
+        sockaddr_un address{};
+        if (path.size() >= sizeof(address.sun_path)) {
+            LAF_LOG_ERROR("Socket path too long: {}", path);
+            return -1;
+        }
+        address.sun_family = AF_UNIX;
+        std::memcpy(address.sun_path, path.c_str(), path.size() + 1);
+
+        const int fd = ::socket(AF_UNIX, SOCK_STREAM | SOCK_NONBLOCK | SOCK_CLOEXEC, 0);
+        if (fd < 0) {
+            reportError("socket");
+            return -1;
+        }
+
+        if (!removeStaleSocket(path, address)) {
+            ::close(fd);
+            return -1;
+        }
+        if (::bind(fd, reinterpret_cast<const sockaddr*>(&address), sizeof(address)) != 0 ||
+            ::listen(fd, SOMAXCONN) != 0 || ::lstat(path.c_str(), &bound) != 0) {
+            reportError("bind/listen");
+            ::close(fd);
+            return -1;
+        }
+        return fd;
+    }
+
+    // Unlinks @p path only while it is still the socket this process bound
+    void removeOwnSocket(const std::string& path, const struct stat& bound) {
+        struct stat status{};
+        if (::lstat(path.c_str(), &status) == 0 && status.st_dev == bound.st_dev && status.st_ino == bound.st_ino) {
+            ::unlink(path.c_str());
+        }
+    }
+
+    // epoll_wait() timeout until @p deadline, rounded up so the wake lands at or after it
+    int timeoutUntil(std::optional<LockedAndFlow::TimerPool::TimePoint> deadline,
+                     LockedAndFlow::TimerPool::TimePoint now) {
+        if (!deadline) {
+            return -1;
+        }
+        if (*deadline <= now) {
+            return 0;
+        }
+        const auto wait = std::chrono::ceil<std::chrono::milliseconds>(*deadline - now);
+        return static_cast<int>(std::min<std::chrono::milliseconds::rep>(wait.count(), 24 * 60 * 60 * 1000));
+    }
+
+    class Daemon {
+    public:
+        Daemon(int epollFd, int listenFd)
+            : epollFd_(epollFd), listenFd_(listenFd), protocol_(pool_) {
+        }
+
+        ~Daemon() {
+            for (const auto& [fd, connection] : connections_) {
+                ::close(fd);
+            }
+        }
+
+        std::optional<LockedAndFlow::TimerPool::TimePoint> nextDeadline() const { return pool_.nextDeadline(); }
+
+        // Stops timers that reached their target before any request sees them
+        void expireTimers(LockedAndFlow::TimerPool::TimePoint now) {
+            expired_.clear();
+            pool_.updateAll(now, &expired_);
+            for (const auto handle : expired_) {
+                LAF_LOG_INFO("Target reached: {} at {}", protocol_.getName(handle), pool_.getElapsed(handle, now));
+            }
+        }
+
+        void acceptClients() {
+            for (;;) {
+                const int fd = ::accept4(listenFd_, nullptr, nullptr, SOCK_NONBLOCK | SOCK_CLOEXEC);
+                if (fd < 0) {
+                    if (errno != EAGAIN && errno != EWOULDBLOCK && errno != EINTR) {
+                        reportError("accept");
+                    }
+                    return;
+                }
+
+                epoll_event event{};
+                event.events = Connection{}.interest;
+                event.data.fd = fd;
+                if (::epoll_ctl(epollFd_, EPOLL_CTL_ADD, fd, &event) != 0) {
+                    reportError("epoll_ctl");
+                    ::close(fd);
+                    continue;
+                }
+                connections_.emplace(fd, Connection{});
+            }
+        }
+
+        void handleClient(int fd, std::uint32_t events, LockedAndFlow::TimerPool::TimePoint now) {
+            const auto it = connections_.find(fd);
+            if (it == connections_.end()) {
+                return;
+            }
+            Connection& connection = it->second;
+
+            if (events & EPOLLERR) {
+                close(fd);
+                return;
+            }
+            if (!connection.closing && (events & (EPOLLIN | EPOLLRDHUP | EPOLLHUP))) {
+                connection.closing = !readRequests(fd, connection, now);
+            }
+            // Even a client that has hung up gets the replies to what it sent
+            if (!flushReplies(fd, connection) || (connection.closing && connection.replies.empty())) {
+                close(fd);
+                return;
+            }
+            updateInterest(fd, connection);
+        }
+
+    private:
+        int epollFd_;
+        int listenFd_;
+        LockedAndFlow::TimerPool pool_;
+        LockedAndFlow::ControlProtocol protocol_;
+        std::unordered_map<int, Connection> connections_;
+        std::vector<LockedAndFlow::TimerPool::Handle> expired_;
+        std::vector<char> readBuffer_ = std::vector<char>(kReadChunk);
+
+        // Reads and executes everything available with one clock sample; the replies
+        // accumulate and go out together. @return false once the peer stops sending
+        bool readRequests(int fd, Connection& connection, LockedAndFlow::TimerPool::TimePoint now) {
+            bool open = true;
+            while (connection.replies.size() < kMaxPendingReplies) {
+                const ssize_t received = ::read(fd, readBuffer_.data(), readBuffer_.size());
+                if (received > 0) {
+                    connection.input.append(readBuffer_.data(), static_cast<std::size_t>(received));
+                    const auto consumed = protocol_.process(connection.input, now, connection.replies);
+                    connection.input.erase(0, consumed);
+                    if (connection.input.size() > LockedAndFlow::ControlProtocol::kMaxLineLength) {
+                        return false; // Not a protocol client
+                    }
+                    continue;
+                }
+                if (received < 0 && errno == EINTR) {
+                    continue;
+                }
+                if (received < 0 && (errno == EAGAIN || errno == EWOULDBLOCK)) {
+                    break;
+                }
+                open = false; // EOF or a hard error
+                break;
+            }
+            return open;
+        }
+
+        // @return false if the connection is broken
+        bool flushReplies(int fd, Connection& connection) {
+            std::size_t sent = 0;
+            while (sent < connection.replies.size()) {
+                const ssize_t written = ::send(fd, connection.replies.data() + sent,
+                    connection.replies.size() - sent, MSG_NOSIGNAL);
+                if (written > 0) {
+                    sent += static_cast<std::size_t>(written);
+                    continue;
+                }
+                if (written < 0 && errno == EINTR) {
+                    continue;
+                }
+                if (written < 0 && (errno == EAGAIN || errno == EWOULDBLOCK)) {
+                    break;
+                }
+                return false;
+            }
+            connection.replies.erase(0, sent);
+            return true;
+        }
+
+        // Wait for writability while replies are pending; stop reading while too many are
+        // pending or once the connection is closing
+        void updateInterest(int fd, Connection& connection) {
+            std::uint32_t interest = connection.closing ? 0u : static_cast<std::uint32_t>(EPOLLRDHUP);
+            if (!connection.closing && connection.replies.size() < kMaxPendingReplies) {
+                interest |= EPOLLIN;
+            }
+            if (!connection.replies.empty()) {
+                interest |= EPOLLOUT;
+            }
+            if (interest == connection.interest) {
+                return; // The common case: no syscall
+            }
+
+            epoll_event event{};
+            event.events = interest;
+            event.data.fd = fd;
+            ::epoll_ctl(epollFd_, EPOLL_CTL_MOD, fd, &event);
+            connection.interest = interest;
+        }
+
+        void close(int fd) {
+            ::epoll_ctl(epollFd_, EPOLL_CTL_DEL, fd, nullptr);
+            ::close(fd);
+            connections_.erase(fd);
+        }
+    };
+
+} // namespace
+
+int main(int argc, char* argv[])
+{
+    std::string socketPath = defaultSocketPath();
+    for (int i = 1; i + 1 < argc; ++i) {
+        if (std::string(argv[i]) == "--socket") {
+            socketPath = argv[i + 1];
+        }
+    }
+
+    // SIGINT/SIGTERM arrive through the epoll set instead of interrupting it
+    sigset_t signals;
+    sigemptyset(&signals);
+    sigaddset(&signals, SIGINT);
+    sigaddset(&signals, SIGTERM);
+    sigprocmask(SIG_BLOCK, &signals, nullptr);
+    const int signalFd = ::signalfd(-1, &signals, SFD_NONBLOCK | SFD_CLOEXEC);
+
+    // openListener() reports its own failures, which are not always errno ones
+    struct stat boundSocket{};
+    const int listenFd = openListener(socketPath, boundSocket);
+    if (listenFd < 0) {
+        return 1;
+    }
+    const int epollFd = ::epoll_create1(EPOLL_CLOEXEC);
+    if (signalFd < 0 || epollFd < 0) {
+        reportError("Daemon startup failed");
+        return 1;
+    }
+
+    for (const int fd : { listenFd, signalFd }) {
+        epoll_event event{};
+        event.events = EPOLLIN;
+        event.data.fd = fd;
+        ::epoll_ctl(epollFd, EPOLL_CTL_ADD, fd, &event);
+    }
+
+    LAF_LOG_INFO("Listening on {}", socketPath);
+
+    {
+        Daemon daemon(epollFd, listenFd);
+        epoll_event events[kMaxEventsPerWait];
+        bool running = true;
+
+        while (running) {
+            const int timeout = timeoutUntil(daemon.nextDeadline(), LockedAndFlow::TimerPool::TimePoint::clock::now());
+            const int ready = ::epoll_wait(epollFd, events, kMaxEventsPerWait, timeout);
+            if (ready < 0 && errno != EINTR) {
+                reportError("epoll_wait");
+                break;
+            }
+
+            // One clock sample per wake, shared by expiry and every request in the batch
+            const auto now = LockedAndFlow::TimerPool::TimePoint::clock::now();
+            daemon.expireTimers(now);
+
+            for (int i = 0; i < ready; ++i) {
+                const int fd = events[i].data.fd;
+                if (fd == listenFd) {
+                    daemon.acceptClients();
+                }
+                else if (fd == signalFd) {
+                    running = false;
+                }
+                else {
+                    daemon.handleClient(fd, events[i].events, now);
+                }
+            }
+        }
+    }
+
+    ::close(epollFd);
+    ::close(listenFd);
+    ::close(signalFd);
+    removeOwnSocket(socketPath, boundSocket);
+
+    LAF_LOG_INFO("Daemon terminated successfully");
+    return 0;
+}
@@ -1,36 +1,254 @@
 #include <SFML/Graphics.hpp>
+#include <algorithm>
+#include <charconv>
+#include <cstdint>
+#include <cstdio>
 #include <iostream>
+#include <optional>
+#include <random>
+#include <string>
+#include <string_view>
+#include <vector>
+#include "FramePacer.h"
+#include "FrameProfiler.h"
+#include "DefaultFont.h"
+#include "LayerCache.h"
+#include "Logger.h"
+#include "RollupTable.h"
+#include "SessionJournal.h"
+#include "SessionStore.h"
+#include "StartupProfile.h"
 #include "Timer.h"
+#include "TimerCommandQueue.h"
+#include "TimerDashboard.h"
 #include "TimerDisplay.h"
+#include "TimerPool.h"
 
-int main()
+namespace {
+
+    // waitEvent() polls in coarse steps, so short paced waits sleep precisely and then poll
+    std::optional<sf::Event> waitForEvent(sf::Window& window, std::optional<std::chrono::microseconds> wait) {
+        constexpr std::chrono::microseconds kPreciseSleepLimit(20000);
+        if (!wait) {
+            return window.waitEvent(); // No timeout: until input arrives
+        }
+        if (*wait <= kPreciseSleepLimit) {
+            sf::sleep(sf::microseconds(wait->count()));
+            return window.pollEvent();
+        }
+        return window.waitEvent(sf::microseconds(wait->count()));
+    }
+
+    // Beyond this the demo only exhausts memory; TimerPool handles are 32-bit anyway
+    constexpr std::size_t kMaxDashboardTimers = 1000000;
+
+    // Timer count for --dashboard; empty unless the whole argument is a number in range
+    std::optional<std::size_t> parseTimerCount(std::string_view text) {
+        std::size_t count = 0;
+        const auto result = std::from_chars(text.data(), text.data() + text.size(), count);
+        if (result.ec != std::errc() || result.ptr != text.data() + text.size() ||
+            count == 0 || count > kMaxDashboardTimers) {
+            return std::nullopt;
+        }
+        return count;
+    }
+
+    void printUsage(const char* program) {
+        std::fprintf(stderr, "usage: %s [--profile-startup] [--dashboard <timers, 1-%zu>]\n", program, kMaxDashboardTimers);
+    }
+
+    // Dashboard demo: a grid over a pool of running timers with random targets
+    int runDashboard(sf::RenderWindow& window, std::size_t timerCount) {
+        using FrameClock = LockedAndFlow::FrameProfiler::Clock;
+
+        LockedAndFlow::TimerPool pool;
+        pool.reserve(timerCount);
+        std::vector<LockedAndFlow::TimerPool::Handle> timers;
+        timers.reserve(timerCount);
+
+        std::mt19937 random(7);
+        const auto start = FrameClock::now();
+        for (std::size_t i = 0; i < timerCount; ++i) {
+            const auto timer = pool.create();
+            pool.setTargetDuration(timer, std::chrono::minutes(5 + random() % 55));
+            pool.start(timer, start - std::chrono::milliseconds(random() % 300000));
+            timers.push_back(timer);
+        }
+
+        LockedAndFlow::TimerDashboard dashboard(pool, sf::FloatRect({ 0.0f, 0.0f }, sf::Vector2f(window.getSize())));
+        dashboard.setTimers(std::move(timers));
+
+        // Timers tick at staggered sub-second phases, so pace continuously and skip unchanged frames
+        LockedAndFlow::FramePacer pacer;
+        LockedAndFlow::FrameProfiler profiler;
+        pacer.setAnimating(true);
+        constexpr float kLineScroll = 60.0f;
+
+        while (window.isOpen()) {
+            std::optional<sf::Event> event = waitForEvent(window,
+                std::chrono::duration_cast<std::chrono::microseconds>(
+                    pacer.getTimeUntilNextFrame(FrameClock::now()).value_or(FrameClock::duration::zero())));
+
+            const auto now = FrameClock::now();
+            profiler.beginFrame(now);
+            bool needsRedraw = event.has_value();
+            while (event) {
+                if (event->is<sf::Event::Closed>()) {
+                    window.close();
+                }
+                else if (const auto* resized = event->getIf<sf::Event::Resized>()) {
+                    const sf::FloatRect area({ 0.0f, 0.0f }, sf::Vector2f(resized->size));
+                    window.setView(sf::View(area));
+                    dashboard.setArea(area);
+                }
+                else if (const auto* wheel = event->getIf<sf::Event::MouseWheelScrolled>()) {
+                    dashboard.scrollBy(-wheel->delta * kLineScroll);
+                }
+                else if (const auto* keyPressed = event->getIf<sf::Event::KeyPressed>()) {
+                    const float page = dashboard.getArea().size.y;
+                    switch (keyPressed->scancode) {
+                    case sf::Keyboard::Scan::Up:       dashboard.scrollBy(-kLineScroll); break;
+                    case sf::Keyboard::Scan::Down:     dashboard.scrollBy(kLineScroll); break;
+                    case sf::Keyboard::Scan::PageUp:   dashboard.scrollBy(-page); break;
+                    case sf::Keyboard::Scan::PageDown: dashboard.scrollBy(page); break;
+                    case sf::Keyboard::Scan::Home:     dashboard.scrollTo(0.0f); break;
+                    case sf::Keyboard::Scan::End:      dashboard.scrollTo(dashboard.getContentHeight()); break;
+                    case sf::Keyboard::Scan::Escape:   window.close(); break;
+                    default: break;
+                    }
+                }
+                event = window.pollEvent();
+            }
+            if (!window.isOpen()) {
+                break;
+            }
+            profiler.endPhase(LockedAndFlow::FramePhase::Events, FrameClock::now());
+
+            needsRedraw = dashboard.update(now) || needsRedraw;
+            profiler.endPhase(LockedAndFlow::FramePhase::Update, FrameClock::now());
+            if (!needsRedraw) {
+                continue;
+            }
+
+            window.clear(sf::Color::Black);
+            dashboard.draw(window);
+            profiler.endPhase(LockedAndFlow::FramePhase::Draw, FrameClock::now());
+
+            window.display();
+            const auto presented = FrameClock::now();
+            profiler.endPhase(LockedAndFlow::FramePhase::Present, presented);
+            profiler.endFrame(presented);
+            pacer.framePresented(presented, presented - now);
+        }
+
+        LAF_LOG_INFO("Dashboard: {} timers, {} panels allocated, {} draw calls per frame",
+            dashboard.getTimerCount(), dashboard.getPanelCount(), dashboard.getDrawCallCount());
+        LockedAndFlow::defaultLogger().flush(); // Keep the report after the log lines
+        profiler.writeReport(std::cout);
+        return 0;
+    }
+
+} // namespace
+
+int main(int argc, char* argv[])
 {
+    // Startup milestones; --profile-startup exits once history is loaded and prints them
+    LockedAndFlow::StartupProfile startup;
+    bool profileStartupOnly = false;
+    // --dashboard N shows N pooled timers in a scrollable grid instead of the single timer
+    std::optional<std::size_t> dashboardTimers;
+    for (int i = 1; i < argc; ++i) {
+        const std::string_view argument = argv[i];
+        if (argument == "--profile-startup") {
+            profileStartupOnly = true;
+        }
+        else if (argument == "--dashboard") {
+            dashboardTimers = i + 1 < argc ? parseTimerCount(argv[++i]) : std::nullopt;
+            if (!dashboardTimers) {
+                printUsage(argv[0]);
+                return 1;
+            }
+        }
+    }
+
     // SFML 3.0 uses different VideoMode constructor
     sf::RenderWindow window(sf::VideoMode({ 800, 600 }), "Locked and Flow - Timer Demo");
-    window.setFramerateLimit(60);
+    startup.mark(LockedAndFlow::StartupMark::WindowCreated);
+
+    if (dashboardTimers) {
+        return runDashboard(window, *dashboardTimers);
+    }
 
-    // Create timer and display components
+    // Create timer and display components. The font is opened from memory and the
+    // display bakes its clock glyphs, the only startup work the first frame needs
     LockedAndFlow::Timer timer;
+    LockedAndFlow::getDefaultFont();
+    startup.mark(LockedAndFlow::StartupMark::FontLoaded);
     LockedAndFlow::TimerDisplay timerDisplay(sf::Vector2f(250.0f, 200.0f));
+    startup.mark(LockedAndFlow::StartupMark::DisplayCreated);
 
-    // Set up timer callback for real-time updates
-    timer.setUpdateCallback([&](LockedAndFlow::Timer::Duration elapsed) {
-        // This callback gets called whenever timer state changes
-        // Could be used for logging, notifications, etc.
-        static auto lastSecond = elapsed.count() / 1000;
-        auto currentSecond = elapsed.count() / 1000;
+    // Persistence is opened by loadHistory() once the first frame is on screen; until
+    // then the objects are closed and ignore appends, and timer commands wait in the queue
+    LockedAndFlow::SessionJournal journal;
+    LockedAndFlow::SessionStore sessions;
+    LockedAndFlow::RollupTable rollups;
+    bool historyLoaded = false;
 
-        if (currentSecond != lastSecond && timer.isRunning()) {
-            std::cout << "Timer running: " << currentSecond << " seconds\n";
-            lastSecond = currentSecond;
+    const auto loadHistory = [&]() {
+        // Session journal: restore the previous session, then record every transition.
+        // Synced at most once a second so an fsync never lands on every keypress.
+        if (journal.open("lockedandflow.journal",
+            LockedAndFlow::JournalSyncPolicy::everyInterval(std::chrono::seconds(1)))) {
+            if (journal.restoreTimer(timer, LockedAndFlow::wallNow(), LockedAndFlow::Timer::ClockType::now())) {
+                LAF_LOG_INFO("Restored session: {}", timer.getElapsed());
+            }
         }
-        });
+        else {
+            LAF_LOG_WARN("Session journal unavailable, history will not be saved");
+        }
+        startup.mark(LockedAndFlow::StartupMark::JournalReplayed);
 
-    // Instructions text
-    sf::Font instructionsFont;
-    // Using empty font - in production you'd load a proper font file
+        // Session history for time-range queries, derived from the same transitions
+        if (sessions.open("lockedandflow.sessions")) {
+            if (sessions.getSessionCount() == 0 && journal.getRecordCount() > 0) {
+                sessions.rebuildFromJournal("lockedandflow.journal");
+            }
+            if (journal.getLastRecord()) {
+                sessions.applyJournalRecord(*journal.getLastRecord()); // Pick up a restored run
+            }
+        }
+
+        // Daily/weekly/monthly totals, caught up with any sessions stored since the last save
+        rollups.load("lockedandflow.rollups");
+        rollups.catchUp(sessions);
+        LAF_LOG_INFO("Focus today: {} min, this week: {} min",
+            rollups.getDayTotal(LockedAndFlow::wallNow()).count() / 60000,
+            rollups.getWeekTotal(LockedAndFlow::wallNow()).count() / 60000);
+        startup.mark(LockedAndFlow::StartupMark::HistoryLoaded);
+        historyLoaded = true;
+    };
+
+    const auto recordTransition = [&](LockedAndFlow::JournalEvent event) {
+        const auto record = LockedAndFlow::JournalRecord::fromTimer(event, timer, LockedAndFlow::wallNow());
+        journal.append(record);
+        sessions.applyJournalRecord(record);
 
-    sf::Text instructions(instructionsFont);
+        // A pause or stop that ended a run adds one session: O(1) rollup update. The
+        // table is saved with the journal's next sync, not here on every keypress.
+        rollups.catchUp(sessions);
+    };
+
+    // Timer observers: log each new second, and journal the automatic stop at the target
+    timer.subscribe([](const LockedAndFlow::TimerNotification& notification) {
+        LAF_LOG_INFO("Timer running: {}", notification.elapsed);
+        }, LockedAndFlow::TimerEvent::Tick);
+    timer.subscribe([&recordTransition](const LockedAndFlow::TimerNotification& notification) {
+        recordTransition(LockedAndFlow::JournalEvent::Stop);
+        LAF_LOG_INFO("Target reached at {}", notification.elapsed);
+        }, LockedAndFlow::TimerEvent::TargetReached);
+
+    // Instructions text, in the font compiled into the binary
+    sf::Text instructions(LockedAndFlow::getDefaultFont());
     instructions.setCharacterSize(16);
     instructions.setFillColor(sf::Color::White);
     instructions.setPosition(sf::Vector2f(50.0f, 50.0f));
@@ -40,87 +258,230 @@ int main()
         "S - Stop Timer\n"
         "R - Reset Timer\n"
         "T - Set 30s Target (for testing)\n"
+        "F3 - Frame Timing Overlay\n"
         "ESC - Exit");
 
-    std::cout << "Locked and Flow Timer Demo Started" << std::endl;
-    std::cout << "Use keyboard controls to interact with the timer" << std::endl;
+    LAF_LOG_INFO("Locked and Flow Timer Demo Started");
+    LAF_LOG_INFO("Use keyboard controls to interact with the timer");
 
-    // Main loop
-    while (window.isOpen())
-    {
-        // SFML 3.0 event handling with std::optional
-        while (const std::optional<sf::Event> event = window.pollEvent())
-        {
-            if (event->is<sf::Event::Closed>()) {
-                std::cout << "Window closed. Final timer state: "
-                    << (timer.getElapsed().count() / 1000) << " seconds" << std::endl;
-                window.close();
-            }
+    // The instructions and the timer panel's background and progress track only change
+    // on layout, so they are painted once into a cache and composited with one sprite
+    LockedAndFlow::LayerCache staticLayer("static");
+    std::uint64_t staticLayoutVersion = timerDisplay.getLayoutVersion();
 
-            // Handle keyboard input using SFML 3.0 pattern
-            else if (const auto* keyPressed = event->getIf<sf::Event::KeyPressed>()) {
-                switch (keyPressed->scancode) {
-                case sf::Keyboard::Scan::Space:
-                    if (timer.isStopped() || timer.isPaused()) {
-                        timer.start();
-                        std::cout << "Timer started!" << std::endl;
-                    }
-                    break;
+    // Frame timing overlay, toggled with F3
+    sf::Text frameOverlay(LockedAndFlow::getDefaultFont());
+    frameOverlay.setCharacterSize(12);
+    frameOverlay.setFillColor(sf::Color(180, 180, 180));
+    frameOverlay.setPosition(sf::Vector2f(50.0f, 420.0f));
+    bool showOverlay = false;
 
-                case sf::Keyboard::Scan::P:
-                    if (timer.isRunning()) {
-                        timer.pause();
-                        std::cout << "Timer paused at " << (timer.getElapsed().count() / 1000) << " seconds" << std::endl;
-                    }
-                    break;
+    // Timer operations from any thread (keyboard included) are applied here, on the
+    // owning thread, so Timer stays single-threaded and the loop never locks
+    LockedAndFlow::TimerCommandQueue commands;
+    const auto applyCommand = [&](const LockedAndFlow::TimerCommand& command, LockedAndFlow::Timer::TimePoint now) {
+        if (!LockedAndFlow::TimerCommandQueue::apply(command, timer, now)) {
+            return; // No-op in the current state (e.g. pause while stopped)
+        }
 
-                case sf::Keyboard::Scan::S:
-                    if (!timer.isStopped()) {
-                        timer.stop();
-                        std::cout << "Timer stopped at " << (timer.getElapsed().count() / 1000) << " seconds" << std::endl;
-                    }
-                    break;
+        switch (command.type) {
+        case LockedAndFlow::TimerCommandType::Start:
+            recordTransition(LockedAndFlow::JournalEvent::Start);
+            LAF_LOG_INFO("Timer started!");
+            break;
+        case LockedAndFlow::TimerCommandType::Pause:
+            recordTransition(LockedAndFlow::JournalEvent::Pause);
+            LAF_LOG_INFO("Timer paused at {}", timer.getElapsed(now));
+            break;
+        case LockedAndFlow::TimerCommandType::Stop:
+            recordTransition(LockedAndFlow::JournalEvent::Stop);
+            LAF_LOG_INFO("Timer stopped at {}", timer.getElapsed(now));
+            break;
+        case LockedAndFlow::TimerCommandType::Reset:
+            recordTransition(LockedAndFlow::JournalEvent::Reset);
+            LAF_LOG_INFO("Timer reset!");
+            break;
+        case LockedAndFlow::TimerCommandType::SetTarget:
+            recordTransition(LockedAndFlow::JournalEvent::TargetChanged);
+            LAF_LOG_INFO("Target duration set to {}", command.target);
+            break;
+        }
+    };
+
+    const auto handleEvent = [&](const sf::Event& event, LockedAndFlow::Timer::TimePoint now) {
+        if (event.is<sf::Event::Closed>()) {
+            LAF_LOG_INFO("Window closed. Final timer state: {}", timer.getElapsed(now));
+            window.close();
+        }
 
-                case sf::Keyboard::Scan::R:
-                    timer.reset();
-                    std::cout << "Timer reset!" << std::endl;
-                    break;
+        // Handle keyboard input using SFML 3.0 pattern
+        else if (const auto* keyPressed = event.getIf<sf::Event::KeyPressed>()) {
+            switch (keyPressed->scancode) {
+            // Timer keys go through the command queue like any other producer
+            case sf::Keyboard::Scan::Space:
+                commands.post(LockedAndFlow::TimerCommandType::Start);
+                break;
 
-                case sf::Keyboard::Scan::T:
-                    // Set a 30-second target for testing progress bar
-                    timer.setTargetDuration(std::chrono::milliseconds(30000));
-                    std::cout << "Target duration set to 30 seconds" << std::endl;
-                    break;
+            case sf::Keyboard::Scan::P:
+                commands.post(LockedAndFlow::TimerCommandType::Pause);
+                break;
 
-                case sf::Keyboard::Scan::Escape:
-                    std::cout << "Exit requested" << std::endl;
-                    window.close();
-                    break;
+            case sf::Keyboard::Scan::S:
+                commands.post(LockedAndFlow::TimerCommandType::Stop);
+                break;
 
-                default:
-                    break;
-                }
+            case sf::Keyboard::Scan::R:
+                commands.post(LockedAndFlow::TimerCommandType::Reset);
+                break;
+
+            case sf::Keyboard::Scan::T:
+                // Set a 30-second target for testing progress bar
+                commands.post(LockedAndFlow::TimerCommandType::SetTarget, std::chrono::milliseconds(30000));
+                break;
+
+            case sf::Keyboard::Scan::F3:
+                showOverlay = !showOverlay;
+                break;
+
+            case sf::Keyboard::Scan::Escape:
+                LAF_LOG_INFO("Exit requested");
+                window.close();
+                break;
+
+            default:
+                break;
             }
         }
+    };
 
-        // Update timer (handles callbacks and target duration checking)
-        timer.update();
+    // Frame pacing: paced frames only while the progress bar animates, otherwise
+    // block until input, a journal sync, an off-thread command or the next visible
+    // change. A stopped or paused timer draws nothing.
+    LockedAndFlow::FramePacer pacer;
+    LockedAndFlow::FrameProfiler profiler;
+    using FrameClock = LockedAndFlow::FrameProfiler::Clock;
+    std::uint64_t framesRendered = 0;
+    std::uint64_t framesSkipped = 0;
+    bool forceRedraw = true; // First frame, and the one after history restores the timer
 
-        // Update display from timer
-        timerDisplay.updateFromTimer(timer);
+    while (window.isOpen())
+    {
+        const auto beforeWait = FrameClock::now();
+        std::optional<std::chrono::microseconds> wait;
+        const auto sooner = [&wait](std::chrono::microseconds candidate) {
+            wait = wait ? std::min(*wait, candidate) : candidate;
+        };
+        if (const auto tick = timer.getTimeUntilNextTick(beforeWait)) {
+            sooner(*tick);
+        }
+        if (const auto flushDue = journal.getTimeUntilFlushDue(beforeWait)) {
+            sooner(*flushDue);
+        }
+        // The keyboard handler's commands are drained in the same iteration. Other
+        // threads cannot wake waitEvent(), so only while one is registered to post
+        // does the loop wake to check the queue
+        if (commands.getProducerCount() != 0) {
+            sooner(LockedAndFlow::TimerCommandQueue::kMaxLatency);
+        }
+        pacer.setAnimating(timer.isRunning() && timer.getTargetDuration().has_value());
+        if (const auto frameDue = pacer.getTimeUntilNextFrame(beforeWait)) {
+            sooner(std::chrono::duration_cast<std::chrono::microseconds>(*frameDue));
+        }
+        std::optional<sf::Event> event = forceRedraw ? window.pollEvent() : waitForEvent(window, wait);
+
+        // Sample the clock once per frame so input handling, update and display agree
+        const auto now = FrameClock::now();
+        profiler.beginFrame(now);
+
+        // Any event (input, resize, focus, expose) warrants a redraw
+        bool needsRedraw = forceRedraw || event.has_value();
+        while (event) {
+            handleEvent(*event, now);
+            event = window.pollEvent();
+        }
+        if (!window.isOpen()) {
+            break;
+        }
+        if (historyLoaded) {
+            commands.drain([&](const LockedAndFlow::TimerCommand& command) { applyCommand(command, now); });
+        }
+        profiler.endPhase(LockedAndFlow::FramePhase::Events, FrameClock::now());
+
+        // Update timer (Tick and TargetReached observers run from here)
+        timer.update(now);
+        const bool journalUnsynced = journal.getTimeUntilFlushDue(now).has_value();
+        journal.flushIfDue();
+        if (journalUnsynced && !journal.getTimeUntilFlushDue(now) && rollups.isDirty()) {
+            // Saved with the journal's interval sync; catchUp() covers a crash in between
+            rollups.save("lockedandflow.rollups");
+        }
+        profiler.endPhase(LockedAndFlow::FramePhase::Update, FrameClock::now());
+
+        // Update display from timer; only a visible change needs a new frame
+        needsRedraw = timerDisplay.updateFromTimer(timer, now) || needsRedraw;
+        profiler.endPhase(LockedAndFlow::FramePhase::Display, FrameClock::now());
+        if (!needsRedraw) {
+            ++framesSkipped;
+            continue;
+        }
 
         // Clear screen
         window.clear(sf::Color::Black);
 
         // Draw everything
-        window.draw(instructions);
-        timerDisplay.draw(window);
+        if (timerDisplay.getLayoutVersion() != staticLayoutVersion) {
+            staticLayoutVersion = timerDisplay.getLayoutVersion();
+            staticLayer.invalidate();
+        }
+        staticLayer.draw(window, [&](sf::RenderTarget& target) {
+            target.draw(instructions);
+            timerDisplay.drawStatic(target);
+        });
+        timerDisplay.drawDynamic(window);
+        if (showOverlay) {
+            char rate[96];
+            std::snprintf(rate, sizeof(rate), "target %u Hz%s, static layer %llu redraws\n", pacer.getTargetRate(),
+                pacer.isAnimating() ? " (animating)" : " (idle)",
+                static_cast<unsigned long long>(staticLayer.getRedrawCount()));
+            frameOverlay.setString(rate + profiler.getSummary());
+            window.draw(frameOverlay);
+        }
+        profiler.endPhase(LockedAndFlow::FramePhase::Draw, FrameClock::now());
 
         // Display
         window.display();
+        const auto presented = FrameClock::now();
+        profiler.endPhase(LockedAndFlow::FramePhase::Present, presented);
+        profiler.endFrame(presented);
+        pacer.framePresented(presented, presented - now);
+        ++framesRendered;
+        forceRedraw = false;
+
+        // Everything the first frame did not need loads now, off the path to first paint
+        if (!historyLoaded) {
+            startup.mark(LockedAndFlow::StartupMark::FirstFrame, presented);
+            LAF_LOG_INFO("First frame presented {} us after start",
+                static_cast<std::uint64_t>(startup.getElapsed(LockedAndFlow::StartupMark::FirstFrame)->count()));
+            loadHistory();
+            forceRedraw = true;
+            if (profileStartupOnly) {
+                window.close();
+            }
+        }
     }
 
+    if (rollups.isDirty()) {
+        rollups.save("lockedandflow.rollups");
+    }
 
-    std::cout << "Application terminated successfully" << std::endl;
+    LAF_LOG_INFO("Frames: {} rendered, {} skipped", framesRendered, framesSkipped);
+    LAF_LOG_INFO("Display rebuilds: {} performed, {} skipped",
+        timerDisplay.getPerformedRebuilds(), timerDisplay.getSkippedRebuilds());
+    LAF_LOG_INFO("Layer {}: {} redraws, {} composites",
+        staticLayer.getName(), staticLayer.getRedrawCount(), staticLayer.getCompositeCount());
+    LockedAndFlow::defaultLogger().flush(); // Keep the report after the log lines
+    profiler.writeReport(std::cout);
+    startup.writeReport(std::cout);
+    LAF_LOG_INFO("Application terminated successfully");
     return 0;
 }
\ No newline at end of file
@@ -0,0 +1,110 @@
+#include "Test.h"
+#include "ControlProtocol.h"
+
+namespace LockedAndFlow::Test {
+
+    namespace {
+
+        using namespace std::chrono_literals;
+
+        const TimerPool::TimePoint kStart = TimerPool::TimePoint() + 1h;
+
+        struct Session {
+            TimerPool pool;
+            ControlProtocol protocol{ pool };
+            std::string replies;
+
+            // Runs @p input through process() and returns the bytes consumed
+            std::size_t send(std::string_view input, TimerPool::TimePoint now = kStart) {
+                return protocol.process(input, now, replies);
+            }
+
+            std::string takeReplies() {
+                std::string taken;
+                taken.swap(replies);
+                return taken;
+            }
+        };
+
+    } // namespace
+
+    LAF_TEST(ControlProtocol, pipelinedLinesReplyInOrder) {
+        Session session;
+        const std::string_view input = "start a\ntarget a 1500\nping\nquery b\nstart b\nlist\n";
+        LAF_CHECK_EQ(session.send(input), input.size());
+
+        const std::string replies = session.takeReplies();
+        LAF_CHECK(replies.rfind("ok running 0 -\nok running 0 1500\nok pong\nerr no such timer\nok running 0 -\nok 2 ", 0) == 0);
+        LAF_CHECK_EQ(session.protocol.getRequestCount(), std::uint64_t{ 6 });
+        LAF_CHECK_EQ(session.protocol.getErrorCount(), std::uint64_t{ 1 });
+        LAF_CHECK_EQ(session.protocol.getTimerCount(), std::size_t{ 2 });
+    }
+
+    LAF_TEST(ControlProtocol, partialLineWaitsForTheRest) {
+        Session session;
+        std::string buffer = "ping\nsta";
+        std::size_t consumed = session.send(buffer);
+        LAF_CHECK_EQ(consumed, std::size_t{ 5 });
+        LAF_CHECK_EQ(session.takeReplies(), std::string("ok pong\n"));
+
+        // The transport keeps the unconsumed tail and appends the next read to it
+        buffer.erase(0, consumed);
+        buffer += "rt a";
+        LAF_CHECK_EQ(session.send(buffer), std::size_t{ 0 });
+        LAF_CHECK(session.takeReplies().empty());
+
+        buffer += "\n";
+        LAF_CHECK_EQ(session.send(buffer, kStart + 2s), buffer.size());
+        LAF_CHECK_EQ(session.takeReplies(), std::string("ok running 0 -\n"));
+        LAF_CHECK_EQ(session.send("query a\n", kStart + 2500ms), std::size_t{ 8 });
+        LAF_CHECK_EQ(session.takeReplies(), std::string("ok running 500 -\n"));
+    }
+
+    LAF_TEST(ControlProtocol, crlfLinesAreAccepted) {
+        Session session;
+        const std::string_view input = "start a\r\ntarget a 10\r\n\r\nping\r\n";
+        LAF_CHECK_EQ(session.send(input), input.size());
+        LAF_CHECK_EQ(session.takeReplies(), std::string("ok running 0 -\nok running 0 10\nok pong\n"));
+        LAF_CHECK_EQ(session.protocol.getErrorCount(), std::uint64_t{ 0 });
+
+        // The name does not keep the '\r'
+        LAF_CHECK_EQ(session.send("query a\n"), std::size_t{ 8 });
+        LAF_CHECK_EQ(session.takeReplies(), std::string("ok running 0 10\n"));
+    }
+
+    LAF_TEST(ControlProtocol, overlongLinesAreRejected) {
+        Session session;
+        const std::string longest = "start " + std::string(ControlProtocol::kMaxNameLength, 'n');
+        const std::string longName = "start " + std::string(ControlProtocol::kMaxNameLength + 1, 'n');
+        const std::string longLine = "ping" + std::string(ControlProtocol::kMaxLineLength, ' ') + "x";
+
+        session.send(longest + "\n" + longName + "\n" + longLine + "\n");
+        LAF_CHECK_EQ(session.takeReplies(), std::string("ok running 0 -\nerr name too long\nerr line too long\n"));
+        LAF_CHECK_EQ(session.protocol.getTimerCount(), std::size_t{ 1 });
+
+        // An unterminated tail past the limit is left for the transport to drop
+        const std::string flood(ControlProtocol::kMaxLineLength + 1, 'x');
+        LAF_CHECK_EQ(session.send("ping\n" + flood), std::size_t{ 5 });
+        LAF_CHECK_EQ(session.takeReplies(), std::string("ok pong\n"));
+    }
+
+    LAF_TEST(ControlProtocol, badDurationsAreRejected) {
+        Session session;
+        for (const std::string_view argument : { "", "x", "-5", "12x", "1.5", "+5", "0x10",
+            "99999999999999999999", "9223372036854775807" }) {
+            session.send("target a " + std::string(argument) + "\n");
+            if (!LAF_CHECK_EQ(session.takeReplies(), std::string("err bad duration\n"))) {
+                std::printf("    argument '%.*s'\n", static_cast<int>(argument.size()), argument.data());
+            }
+        }
+        LAF_CHECK_EQ(session.protocol.getTimerCount(), std::size_t{ 0 });
+
+        const std::string longest = std::to_string(ControlProtocol::kMaxTargetMs);
+        session.send("target a " + longest + "\ntarget a " + std::to_string(ControlProtocol::kMaxTargetMs + 1) + "\n");
+        LAF_CHECK_EQ(session.takeReplies(), "ok stopped 0 " + longest + "\nerr bad duration\n");
+
+        session.send("target a 0\n");
+        LAF_CHECK_EQ(session.takeReplies(), std::string("ok stopped 0 -\n"));
+    }
+
+} // namespace LockedAndFlow::Test
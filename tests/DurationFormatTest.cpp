@@ -0,0 +1,145 @@
+#include "Test.h"
+#include "DurationFormat.h"
+#include <cstring>
+#include <iomanip>
+#include <limits>
+#include <random>
+#include <sstream>
+#include <string>
+
+namespace LockedAndFlow::Test {
+
+    namespace {
+
+        using namespace std::chrono_literals;
+        using Duration = Timer::Duration;
+
+        // The ostringstream formatting the kernel replaced, extended with the
+        // minutes-only style, fractional digits and a sign on the magnitude
+        std::string referenceFormat(Duration duration, DurationStyle style, unsigned fractionalDigits) {
+            const std::int64_t count = duration.count();
+            const std::uint64_t milliseconds = count < 0
+                ? static_cast<std::uint64_t>(-(count + 1)) + 1
+                : static_cast<std::uint64_t>(count);
+            const std::uint64_t totalSeconds = milliseconds / 1000;
+
+            std::ostringstream oss;
+            if (count < 0) {
+                oss << '-';
+            }
+            if (style == DurationStyle::HoursMinutesSeconds) {
+                oss << std::setfill('0') << std::setw(2) << totalSeconds / 3600 << ":"
+                    << std::setfill('0') << std::setw(2) << (totalSeconds % 3600) / 60 << ":";
+            }
+            else {
+                oss << std::setfill('0') << std::setw(2) << totalSeconds / 60 << ":";
+            }
+            oss << std::setfill('0') << std::setw(2) << totalSeconds % 60;
+
+            if (fractionalDigits > 0) {
+                std::ostringstream fraction;
+                fraction << std::setfill('0') << std::setw(3) << milliseconds % 1000;
+                oss << '.' << fraction.str().substr(0, fractionalDigits);
+            }
+            return oss.str();
+        }
+
+        bool matchesReference(Duration duration, DurationStyle style, unsigned fractionalDigits = 0) {
+            const auto text = formatDuration(duration, style, fractionalDigits);
+            const std::string expected = referenceFormat(duration, style, fractionalDigits);
+            const bool nulTerminated = std::strlen(text.c_str()) == text.length;
+            if (!LAF_CHECK(text.view() == expected && nulTerminated)) {
+                std::printf("    %lld ms: got '%s', expected '%s'\n", static_cast<long long>(duration.count()),
+                    text.c_str(), expected.c_str());
+                return false;
+            }
+            return true;
+        }
+
+    } // namespace
+
+    LAF_TEST(DurationFormat, fixedValues) {
+        LAF_CHECK(formatDuration(Duration(0)).view() == "00:00:00");
+        LAF_CHECK(formatDuration(Duration(59999)).view() == "00:00:59");
+        LAF_CHECK(formatDuration(Duration(59999), DurationStyle::MinutesSeconds).view() == "00:59");
+        LAF_CHECK(formatDuration(Duration(60000), DurationStyle::MinutesSeconds).view() == "01:00");
+        LAF_CHECK(formatDuration(99h + 59min + 59s + 999ms).view() == "99:59:59");
+        LAF_CHECK(formatDuration(100h).view() == "100:00:00");
+        LAF_CHECK(formatDuration(123h + 4min + 5s).view() == "123:04:05");
+        LAF_CHECK(formatDuration(125min + 7s, DurationStyle::MinutesSeconds).view() == "125:07");
+    }
+
+    LAF_TEST(DurationFormat, fractionalDigits) {
+        const Duration duration = 1min + 2s + 345ms;
+        LAF_CHECK(formatDuration(duration, DurationStyle::HoursMinutesSeconds, 1).view() == "00:01:02.3");
+        LAF_CHECK(formatDuration(duration, DurationStyle::HoursMinutesSeconds, 2).view() == "00:01:02.34");
+        LAF_CHECK(formatDuration(duration, DurationStyle::HoursMinutesSeconds, 3).view() == "00:01:02.345");
+        LAF_CHECK(formatDuration(duration, DurationStyle::MinutesSeconds, 3).view() == "01:02.345");
+        LAF_CHECK(formatDuration(Duration(7), DurationStyle::HoursMinutesSeconds, 3).view() == "00:00:00.007");
+        LAF_CHECK(formatDuration(Duration(999), DurationStyle::HoursMinutesSeconds, 2).view() == "00:00:00.99");
+
+        // More than three digits are clamped to milliseconds
+        LAF_CHECK(formatDuration(duration, DurationStyle::HoursMinutesSeconds, 9).view() == "00:01:02.345");
+    }
+
+    LAF_TEST(DurationFormat, bufferCapacity) {
+        // "00:00:59": eight characters. Exactly full writes no NUL; one short writes nothing.
+        char buffer[16];
+        std::memset(buffer, '#', sizeof(buffer));
+        LAF_CHECK_EQ(formatDuration(buffer, 8, Duration(59999)), std::size_t{ 8 });
+        LAF_CHECK(std::string_view(buffer, 9) == "00:00:59#");
+
+        std::memset(buffer, '#', sizeof(buffer));
+        LAF_CHECK_EQ(formatDuration(buffer, 9, Duration(59999)), std::size_t{ 8 });
+        LAF_CHECK(std::string_view(buffer, 10) == std::string_view("00:00:59\0#", 10));
+
+        std::memset(buffer, '#', sizeof(buffer));
+        LAF_CHECK_EQ(formatDuration(buffer, 7, Duration(59999)), std::size_t{ 0 });
+        LAF_CHECK(std::string_view(buffer, 8) == "########");
+
+        LAF_CHECK_EQ(formatDuration(buffer, 11, Duration(1500), DurationStyle::HoursMinutesSeconds, 3), std::size_t{ 0 });
+        LAF_CHECK_EQ(formatDuration(buffer, 12, Duration(1500), DurationStyle::HoursMinutesSeconds, 3), std::size_t{ 12 });
+    }
+
+    LAF_TEST(DurationFormat, negativeDurations) {
+        LAF_CHECK(formatDuration(Duration(-1)).view() == "-00:00:00");
+        LAF_CHECK(formatDuration(Duration(-61500), DurationStyle::HoursMinutesSeconds, 1).view() == "-00:01:01.5");
+        LAF_CHECK(formatDuration(-(100h + 1s), DurationStyle::MinutesSeconds).view() == "-6000:01");
+    }
+
+    LAF_TEST(DurationFormat, extremeValues) {
+        const Duration lowest(std::numeric_limits<std::int64_t>::min());
+        const Duration highest(std::numeric_limits<std::int64_t>::max());
+        LAF_CHECK(formatDuration(lowest, DurationStyle::HoursMinutesSeconds, 3).view() == "-2562047788015:12:55.808");
+        LAF_CHECK(formatDuration(lowest, DurationStyle::MinutesSeconds, 3).view() == "-153722867280912:55.808");
+        LAF_CHECK(formatDuration(highest, DurationStyle::HoursMinutesSeconds, 3).view() == "2562047788015:12:55.807");
+
+        for (const Duration duration : { lowest, highest }) {
+            for (const auto style : { DurationStyle::HoursMinutesSeconds, DurationStyle::MinutesSeconds }) {
+                LAF_CHECK(formatDuration(duration, style, 3).length < kMaxFormattedDurationLength);
+            }
+        }
+    }
+
+    LAF_TEST(DurationFormat, matchesOstringstreamFormat) {
+        for (const std::int64_t ms : { 0LL, 999LL, 1000LL, 59999LL, 60000LL, 3599999LL, 3600000LL,
+                 359999999LL, 360000000LL, 3600000000LL }) {
+            for (const std::int64_t signedMs : { ms, -ms }) {
+                matchesReference(Duration(signedMs), DurationStyle::HoursMinutesSeconds);
+                matchesReference(Duration(signedMs), DurationStyle::MinutesSeconds, 2);
+            }
+        }
+
+        // Up to ~1000 hours, both styles and every fractional width
+        std::mt19937_64 random(10);
+        for (int i = 0; i < 20000; ++i) {
+            const auto ms = static_cast<std::int64_t>(random() % (1000LL * 3600 * 1000));
+            const Duration duration(i % 8 == 0 ? -ms : ms);
+            const auto style = i % 2 == 0 ? DurationStyle::HoursMinutesSeconds : DurationStyle::MinutesSeconds;
+            if (!matchesReference(duration, style, static_cast<unsigned>(i % 4))) {
+                return;
+            }
+        }
+    }
+
+} // namespace LockedAndFlow::Test
@@ -0,0 +1,98 @@
+#include "Test.h"
+#include "Logger.h"
+#include <sstream>
+#include <thread>
+#include <vector>
+
+namespace LockedAndFlow::Test {
+
+    namespace {
+
+        using namespace std::chrono_literals;
+
+        std::size_t countLines(const std::string& text, std::string_view needle) {
+            std::size_t count = 0;
+            for (auto position = text.find(needle); position != std::string::npos; position = text.find(needle, position + 1)) {
+                ++count;
+            }
+            return count;
+        }
+
+        // Polls until the writer has written @p count records, without asking it to flush
+        bool waitForWritten(const Logger& logger, std::uint64_t count) {
+            const auto deadline = std::chrono::steady_clock::now() + 5s;
+            while (logger.getWrittenCount() < count) {
+                if (std::chrono::steady_clock::now() > deadline) {
+                    return false;
+                }
+                std::this_thread::sleep_for(1ms);
+            }
+            return true;
+        }
+
+    } // namespace
+
+    LAF_TEST(Logger, flushWritesEverythingQueued) {
+        std::ostringstream out;
+        Logger logger(out);
+        logger.log(LogLevel::Info, "first {} of {}", 1, 2u);
+        logger.log(LogLevel::Warn, "elapsed {}", std::chrono::milliseconds(61000));
+        logger.flush();
+
+        const std::string text = out.str();
+        LAF_CHECK(text.find("INFO  first 1 of 2\n") != std::string::npos);
+        LAF_CHECK(text.find("WARN  elapsed 00:01:01\n") != std::string::npos);
+        LAF_CHECK_EQ(logger.getWrittenCount(), std::uint64_t{ 2 });
+    }
+
+    LAF_TEST(Logger, idleWriterWakesForNextRecord) {
+        std::ostringstream out;
+        Logger logger(out);
+
+        // Each record arrives after the writer has gone back to sleep on an empty ring
+        for (std::uint64_t i = 1; i <= 3; ++i) {
+            std::this_thread::sleep_for(Logger::kFlushInterval + 20ms);
+            logger.log(LogLevel::Info, "record {}", i);
+            LAF_REQUIRE(waitForWritten(logger, i));
+        }
+        logger.flush();
+        LAF_CHECK_EQ(countLines(out.str(), "record "), std::size_t{ 3 });
+    }
+
+    LAF_TEST(Logger, concurrentProducersLoseNothing) {
+        constexpr int kThreads = 4;
+        constexpr int kPerThread = 200;  // Below capacity even if the writer never ran
+
+        std::ostringstream out;
+        Logger logger(out);
+        std::vector<std::thread> threads;
+        for (int t = 0; t < kThreads; ++t) {
+            threads.emplace_back([&logger, t] {
+                for (int i = 0; i < kPerThread; ++i) {
+                    logger.log(LogLevel::Debug, "thread {} line {}", t, i);
+                    if (i % 50 == 0) {
+                        std::this_thread::sleep_for(1ms);
+                    }
+                }
+            });
+        }
+        for (auto& thread : threads) {
+            thread.join();
+        }
+
+        LAF_REQUIRE(waitForWritten(logger, kThreads * kPerThread));
+        logger.flush();
+        LAF_CHECK_EQ(logger.getDroppedCount(), std::uint64_t{ 0 });
+        LAF_CHECK_EQ(countLines(out.str(), " line "), std::size_t{ kThreads * kPerThread });
+    }
+
+    LAF_TEST(Logger, destructorWritesTheRest) {
+        std::ostringstream out;
+        {
+            Logger logger(out);
+            logger.log(LogLevel::Error, "last words");
+        }
+        LAF_CHECK(out.str().find("ERROR last words\n") != std::string::npos);
+    }
+
+} // namespace LockedAndFlow::Test
@@ -0,0 +1,163 @@
+#include "Test.h"
+#include "MpscRing.h"
+#include "TimerCommandQueue.h"
+#include <algorithm>
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace LockedAndFlow::Test {
+
+    namespace {
+
+        struct Tagged {
+            std::uint32_t producer;
+            std::uint32_t sequence;
+        };
+
+        // A deliberately small ring so producers keep hitting the full case. Every
+        // producer's items must arrive exactly once and in order.
+        void checkProducersInOrder(std::size_t producers) {
+            constexpr std::uint32_t kItemsPerProducer = 20000;
+            auto ring = std::make_unique<MpscRing<Tagged, 64>>();
+
+            std::vector<std::thread> threads;
+            for (std::size_t p = 0; p < producers; ++p) {
+                threads.emplace_back([&ring, p] {
+                    for (std::uint32_t i = 0; i < kItemsPerProducer; ++i) {
+                        while (!ring->tryPush(Tagged{ static_cast<std::uint32_t>(p), i })) {
+                            std::this_thread::yield();
+                        }
+                    }
+                });
+            }
+
+            std::vector<std::uint32_t> next(producers, 0);
+            std::size_t failures = 0;
+            Tagged item{};
+            for (std::size_t remaining = producers * kItemsPerProducer; remaining > 0;) {
+                if (!ring->tryPop(item)) {
+                    std::this_thread::yield();
+                    continue;
+                }
+                --remaining;
+
+                // Report the first few problems only; the consumer must keep draining
+                const bool known = item.producer < producers;
+                if (!known || item.sequence != next[item.producer]) {
+                    if (failures++ < 5) {
+                        LAF_CHECK(known);
+                        if (known) {
+                            LAF_CHECK_EQ(item.sequence, next[item.producer]);
+                        }
+                    }
+                    if (!known) {
+                        continue;
+                    }
+                }
+                next[item.producer] = item.sequence + 1;
+            }
+            for (auto& thread : threads) {
+                thread.join();
+            }
+
+            LAF_CHECK_EQ(failures, std::size_t{ 0 });
+            LAF_CHECK(!ring->tryPop(item));
+        }
+
+    } // namespace
+
+    LAF_TEST(MpscRing, singleThreadFifoAndFull) {
+        MpscRing<Tagged, 4> ring;
+        for (std::uint32_t i = 0; i < 4; ++i) {
+            LAF_CHECK(ring.tryPush(Tagged{ 0, i }));
+        }
+        LAF_CHECK(!ring.tryPush(Tagged{ 0, 4 }));
+
+        Tagged item{};
+        for (std::uint32_t i = 0; i < 4; ++i) {
+            LAF_REQUIRE(ring.tryPop(item));
+            LAF_CHECK_EQ(item.sequence, i);
+        }
+        LAF_CHECK(!ring.tryPop(item));
+
+        // Wraps around the cells
+        LAF_CHECK(ring.tryPush(Tagged{ 0, 5 }));
+        LAF_REQUIRE(ring.tryPop(item));
+        LAF_CHECK_EQ(item.sequence, std::uint32_t{ 5 });
+    }
+
+    LAF_TEST(MpscRing, stressTwoProducers) {
+        checkProducersInOrder(2);
+    }
+
+    LAF_TEST(MpscRing, stressEightProducers) {
+        checkProducersInOrder(8);
+    }
+
+    LAF_TEST(MpscRing, commandQueueCountsDroppedPosts) {
+        TimerCommandQueue queue;
+        for (std::size_t i = 0; i < TimerCommandQueue::kCapacity; ++i) {
+            LAF_CHECK(queue.post(TimerCommandType::Start));
+        }
+        LAF_CHECK(!queue.post(TimerCommandType::Pause));
+        LAF_CHECK_EQ(queue.getDroppedCount(), std::uint64_t{ 1 });
+
+        std::size_t starts = 0;
+        LAF_CHECK_EQ(queue.drain([&starts](const TimerCommand& command) {
+            starts += command.type == TimerCommandType::Start;
+        }), TimerCommandQueue::kCapacity);
+        LAF_CHECK_EQ(starts, TimerCommandQueue::kCapacity);
+    }
+
+    LAF_TEST(MpscRing, commandQueueNotifierWakesOwner) {
+        struct Wake {
+            std::mutex mutex;
+            std::condition_variable condition;
+            bool pending = false;
+        } wake;
+
+        TimerCommandQueue queue;
+        queue.setNotifier([&wake] {
+            std::lock_guard<std::mutex> lock(wake.mutex);
+            wake.pending = true;
+            wake.condition.notify_one();
+        });
+
+        // The owner blocks with no timeout of its own; only the notifier can wake it
+        constexpr std::size_t kCommands = 20;
+        std::thread producer([&queue] {
+            queue.registerProducer();
+            for (std::size_t i = 0; i < kCommands; ++i) {
+                std::this_thread::sleep_for(std::chrono::milliseconds(i % 4 == 0 ? 5 : 0));
+                queue.post(TimerCommandType::Start);
+            }
+            queue.unregisterProducer();
+        });
+
+        std::size_t received = 0;
+        Timer::Duration worstLatency{ 0 };
+        while (received < kCommands) {
+            {
+                std::unique_lock<std::mutex> lock(wake.mutex);
+                if (!wake.condition.wait_for(lock, std::chrono::seconds(5), [&wake] { return wake.pending; })) {
+                    break;
+                }
+                wake.pending = false;
+            }
+            queue.drain([&](const TimerCommand& command) {
+                const auto latency = std::chrono::duration_cast<Timer::Duration>(Timer::ClockType::now() - command.issuedAt);
+                worstLatency = std::max(worstLatency, latency);
+                ++received;
+            });
+        }
+        producer.join();
+
+        LAF_CHECK_EQ(received, kCommands);
+        LAF_CHECK(worstLatency < TimerCommandQueue::kMaxLatency);
+        LAF_CHECK_EQ(queue.getProducerCount(), std::uint32_t{ 0 });
+    }
+
+} // namespace LockedAndFlow::Test
@@ -0,0 +1,102 @@
+#include "Test.h"
+#include "RollupTable.h"
+
+namespace LockedAndFlow::Test {
+
+    namespace {
+
+        using namespace std::chrono_literals;
+
+        // 2024-03-04 00:00 UTC, a Monday
+        const WallTime kMonday{ Timer::Duration(1709510400000) };
+
+    } // namespace
+
+    LAF_TEST(RollupTable, totalsForSessionsInTimeOrder) {
+        RollupTable rollups(0min);
+        rollups.addSession(kMonday + 9h, kMonday + 10h);
+        rollups.addSession(kMonday + 24h + 9h, kMonday + 24h + 9h + 30min);
+        rollups.addSession(kMonday + 30 * 24h, kMonday + 30 * 24h + 2h);   // April 3rd
+
+        LAF_CHECK_EQ(rollups.getDayTotal(2024, 3, 4), Timer::Duration(1h));
+        LAF_CHECK_EQ(rollups.getDayTotal(2024, 3, 5), Timer::Duration(30min));
+        LAF_CHECK_EQ(rollups.getDayTotal(2024, 3, 6), Timer::Duration::zero());
+        LAF_CHECK_EQ(rollups.getDayTotal(2024, 4, 3), Timer::Duration(2h));
+        LAF_CHECK_EQ(rollups.getDayTotal(2024, 4, 4), Timer::Duration::zero());
+        LAF_CHECK_EQ(rollups.getWeekTotal(2024, 10), Timer::Duration(90min));
+        LAF_CHECK_EQ(rollups.getMonthTotal(2024, 3), Timer::Duration(90min));
+        LAF_CHECK_EQ(rollups.getMonthTotal(2024, 4), Timer::Duration(2h));
+        LAF_CHECK_EQ(rollups.getMonthTotal(2024, 2), Timer::Duration::zero());
+    }
+
+    LAF_TEST(RollupTable, sessionOlderThanAllOthersExtendsFront) {
+        RollupTable rollups(0min);
+        rollups.addSession(kMonday + 9h, kMonday + 10h);
+        rollups.addSession(kMonday - 3 * 24h, kMonday - 3 * 24h + 15min);  // Friday before
+
+        LAF_CHECK_EQ(rollups.getDayTotal(2024, 3, 1), Timer::Duration(15min));
+        LAF_CHECK_EQ(rollups.getDayTotal(2024, 3, 2), Timer::Duration::zero());
+        LAF_CHECK_EQ(rollups.getDayTotal(2024, 3, 4), Timer::Duration(1h));
+        LAF_CHECK_EQ(rollups.getWeekTotal(2024, 9), Timer::Duration(15min));
+        LAF_CHECK_EQ(rollups.getMonthTotal(2024, 3), Timer::Duration(75min));
+    }
+
+    LAF_TEST(RollupTable, sessionSplitAtLocalMidnight) {
+        RollupTable rollups(120min);
+        rollups.addSession(kMonday - 3h, kMonday - 1h);    // 23:00-01:00 local
+
+        LAF_CHECK_EQ(rollups.getDayTotal(2024, 3, 3), Timer::Duration(1h));
+        LAF_CHECK_EQ(rollups.getDayTotal(2024, 3, 4), Timer::Duration(1h));
+        LAF_CHECK_EQ(rollups.getWeekTotal(2024, 9), Timer::Duration(1h));
+        LAF_CHECK_EQ(rollups.getWeekTotal(2024, 10), Timer::Duration(1h));
+    }
+
+    LAF_TEST(RollupTable, weekAndMonthOutOfRangeReturnZero) {
+        const WallTime december23{ Timer::Duration(1734912000000) };   // 2024-12-23, ISO 2024-W52
+        const WallTime december31{ Timer::Duration(1609372800000) };   // 2020-12-31, ISO 2020-W53
+        RollupTable rollups(0min);
+        rollups.addSession(december31 + 9h, december31 + 10h);
+        rollups.addSession(december23 + 9h, december23 + 10h);
+        rollups.addSession(december23 + 7 * 24h + 9h, december23 + 7 * 24h + 11h);    // 2024-12-30, ISO 2025-W01
+        rollups.addSession(december23 + 10 * 24h + 9h, december23 + 10 * 24h + 12h);   // 2025-01-02
+
+        // 2020 has 53 ISO weeks, 2024 only 52: week 53 must not alias 2025-W01
+        LAF_CHECK_EQ(rollups.getWeekTotal(2020, 53), Timer::Duration(1h));
+        LAF_CHECK_EQ(rollups.getWeekTotal(2020, 54), Timer::Duration::zero());
+        LAF_CHECK_EQ(rollups.getWeekTotal(2024, 52), Timer::Duration(1h));
+        LAF_CHECK_EQ(rollups.getWeekTotal(2024, 53), Timer::Duration::zero());
+        LAF_CHECK_EQ(rollups.getWeekTotal(2025, 1), Timer::Duration(5h));
+        LAF_CHECK_EQ(rollups.getWeekTotal(2025, 0), Timer::Duration::zero());
+
+        // Month 13 must not alias next January, nor month 0 wrap around
+        LAF_CHECK_EQ(rollups.getMonthTotal(2024, 12), Timer::Duration(3h));
+        LAF_CHECK_EQ(rollups.getMonthTotal(2025, 1), Timer::Duration(3h));
+        LAF_CHECK_EQ(rollups.getMonthTotal(2024, 13), Timer::Duration::zero());
+        LAF_CHECK_EQ(rollups.getMonthTotal(2025, 0), Timer::Duration::zero());
+        LAF_CHECK_EQ(rollups.getMonthTotal(2021, 0), Timer::Duration::zero());
+    }
+
+    LAF_TEST(RollupTable, saveAndLoadRoundTrip) {
+        const TempPath path("rollups");
+        RollupTable saved(60min);
+        saved.addSession(kMonday - 3 * 24h, kMonday - 3 * 24h + 15min);
+        saved.addSession(kMonday + 9h, kMonday + 10h);
+        LAF_REQUIRE(saved.save(path.str()));
+        LAF_CHECK(!saved.isDirty());
+
+        RollupTable loaded(60min);
+        LAF_REQUIRE(loaded.load(path.str()));
+        for (unsigned day = 1; day <= 5; ++day) {
+            LAF_CHECK_EQ(loaded.getDayTotal(2024, 3, day), saved.getDayTotal(2024, 3, day));
+        }
+        LAF_CHECK_EQ(loaded.getMonthTotal(2024, 3), Timer::Duration(75min));
+
+        // Appending after a load still lands on the right day
+        loaded.addSession(kMonday + 24h + 9h, kMonday + 24h + 10h);
+        LAF_CHECK_EQ(loaded.getDayTotal(2024, 3, 5), Timer::Duration(1h));
+
+        RollupTable otherZone(0min);
+        LAF_CHECK(!otherZone.load(path.str()));
+    }
+
+} // namespace LockedAndFlow::Test
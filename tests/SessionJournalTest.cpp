@@ -0,0 +1,104 @@
+#include "Test.h"
+#include "SessionJournal.h"
+#include "SessionStore.h"
+
+namespace LockedAndFlow::Test {
+
+    namespace {
+
+        using namespace std::chrono_literals;
+
+        const Timer::TimePoint kSteadyStart = Timer::TimePoint() + 1h;
+        const WallTime kWallStart{ Timer::Duration(1700000000000) };
+
+        // Writes @p records to a new journal and reopens it, as the app does on launch
+        bool reopenWith(SessionJournal& journal, const std::string& path, std::initializer_list<JournalRecord> records) {
+            {
+                SessionJournal writer;
+                if (!writer.open(path, JournalSyncPolicy::everyEvent())) {
+                    return false;
+                }
+                for (const auto& record : records) {
+                    writer.append(record);
+                }
+            }
+            return journal.open(path);
+        }
+
+    } // namespace
+
+    LAF_TEST(SessionJournal, recordIncludesRunningSegment) {
+        Timer timer;
+        timer.start(kSteadyStart);
+        timer.setTargetDuration(25min);
+
+        const auto record = JournalRecord::fromTimer(JournalEvent::TargetChanged, timer, kWallStart + 5s,
+            kSteadyStart + 5s);
+        LAF_CHECK_EQ(record.elapsedMs, std::int64_t{ 5000 });
+        LAF_CHECK_EQ(record.state, TimerState::Running);
+        LAF_CHECK_EQ(record.targetMs, std::int64_t{ 1500000 });
+    }
+
+    LAF_TEST(SessionJournal, restoresRunAfterStartThenTargetChange) {
+        const TempPath path("journal");
+        Timer timer;
+        timer.saveElapsed(2s);
+        timer.start(kSteadyStart);
+        const auto start = JournalRecord::fromTimer(JournalEvent::Start, timer, kWallStart, kSteadyStart);
+        timer.setTargetDuration(25min);
+        const auto targetChanged = JournalRecord::fromTimer(JournalEvent::TargetChanged, timer, kWallStart + 5s,
+            kSteadyStart + 5s);
+
+        SessionJournal journal;
+        LAF_REQUIRE(reopenWith(journal, path.str(), { start, targetChanged }));
+        LAF_CHECK_EQ(journal.getRecordCount(), std::size_t{ 2 });
+
+        // Relaunched 3s after the target change: 2s before the run, 5s + 3s of it
+        const auto restoredAt = Timer::TimePoint() + 7h;
+        Timer restored;
+        LAF_REQUIRE(journal.restoreTimer(restored, kWallStart + 8s, restoredAt));
+        LAF_CHECK_EQ(restored.getState(), TimerState::Running);
+        LAF_CHECK_EQ(restored.getElapsed(restoredAt), Timer::Duration(10s));
+        LAF_CHECK_EQ(restored.getElapsed(restoredAt + 1s), Timer::Duration(11s));
+        LAF_CHECK_EQ(restored.getTargetDuration(), std::optional<Timer::Duration>(25min));
+    }
+
+    LAF_TEST(SessionJournal, restoresPausedTimerWithoutTimeSinceRecord) {
+        const TempPath path("journal");
+        Timer timer;
+        timer.start(kSteadyStart);
+        timer.pause(kSteadyStart + 4s);
+        const auto paused = JournalRecord::fromTimer(JournalEvent::Pause, timer, kWallStart + 4s, kSteadyStart + 4s);
+
+        SessionJournal journal;
+        LAF_REQUIRE(reopenWith(journal, path.str(), { paused }));
+
+        const auto restoredAt = Timer::TimePoint() + 7h;
+        Timer restored;
+        LAF_REQUIRE(journal.restoreTimer(restored, kWallStart + 1h, restoredAt));
+        LAF_CHECK_EQ(restored.getState(), TimerState::Paused);
+        LAF_CHECK_EQ(restored.getElapsed(restoredAt + 1h), Timer::Duration(4s));
+        LAF_CHECK_EQ(restored.getTargetDuration(), std::optional<Timer::Duration>());
+    }
+
+    LAF_TEST(SessionJournal, targetChangeDoesNotSplitSession) {
+        const TempPath path("sessions");
+        SessionStore store;
+        LAF_REQUIRE(store.open(path.str()));
+
+        Timer timer;
+        timer.saveElapsed(2s);
+        timer.start(kSteadyStart);
+        store.applyJournalRecord(JournalRecord::fromTimer(JournalEvent::Start, timer, kWallStart, kSteadyStart));
+        timer.setTargetDuration(25min);
+        store.applyJournalRecord(JournalRecord::fromTimer(JournalEvent::TargetChanged, timer, kWallStart + 5s,
+            kSteadyStart + 5s));
+        timer.pause(kSteadyStart + 9s);
+        store.applyJournalRecord(JournalRecord::fromTimer(JournalEvent::Pause, timer, kWallStart + 9s,
+            kSteadyStart + 9s));
+
+        LAF_CHECK_EQ(store.getSessionCount(), std::size_t{ 1 });
+        LAF_CHECK_EQ(store.getFocusTime(kWallStart - 1h, kWallStart + 1h), Timer::Duration(9s));
+    }
+
+} // namespace LockedAndFlow::Test
@@ -0,0 +1,165 @@
+#include "Test.h"
+#include "SessionStore.h"
+#include <cstdio>
+#include <filesystem>
+#include <vector>
+
+namespace LockedAndFlow::Test {
+
+    namespace {
+
+        using namespace std::chrono_literals;
+
+        constexpr std::size_t kStride = SessionStore::kIndexStride;
+        const WallTime kBase{ Timer::Duration(1700000000000) };
+
+        // 5s sessions every 10s; with @p touching, each ends where the next starts
+        std::vector<SessionRecord> makeSessions(std::size_t count, bool touching) {
+            std::vector<SessionRecord> sessions;
+            for (std::size_t i = 0; i < count; ++i) {
+                const WallTime start = kBase + Timer::Duration(10000) * static_cast<std::int64_t>(i);
+                sessions.push_back({ start, start + (touching ? 10s : 5s) });
+            }
+            return sessions;
+        }
+
+        bool appendAll(SessionStore& store, const std::vector<SessionRecord>& sessions) {
+            for (const auto& session : sessions) {
+                if (!store.append(session.start, session.end)) {
+                    return false;
+                }
+            }
+            return true;
+        }
+
+        // Indices forEachSession() should visit: sessions overlapping [from, to)
+        std::vector<std::size_t> expectedBetween(const std::vector<SessionRecord>& sessions, WallTime from, WallTime to) {
+            std::vector<std::size_t> indices;
+            for (std::size_t i = 0; i < sessions.size(); ++i) {
+                if (sessions[i].end > from && sessions[i].start < to) {
+                    indices.push_back(i);
+                }
+            }
+            return indices;
+        }
+
+        void checkQuery(SessionStore& store, const std::vector<SessionRecord>& sessions, WallTime from, WallTime to) {
+            std::vector<SessionRecord> visited;
+            store.forEachSession(from, to, [&visited](const SessionRecord& session) { visited.push_back(session); });
+
+            const auto expected = expectedBetween(sessions, from, to);
+            if (!LAF_CHECK_EQ(visited.size(), expected.size())) {
+                std::printf("    query [%lld, %lld) ms after base\n",
+                    static_cast<long long>((from - kBase).count()), static_cast<long long>((to - kBase).count()));
+                return;
+            }
+            for (std::size_t i = 0; i < expected.size(); ++i) {
+                LAF_CHECK(visited[i].start == sessions[expected[i]].start && visited[i].end == sessions[expected[i]].end);
+            }
+        }
+
+        // Queries starting and ending on, just before and just after each session
+        // boundary around the given session indices
+        void checkQueriesAround(SessionStore& store, const std::vector<SessionRecord>& sessions,
+            std::initializer_list<std::size_t> indices) {
+            for (const std::size_t index : indices) {
+                for (const WallTime edge : { sessions[index].start, sessions[index].end }) {
+                    for (const Timer::Duration offset : { -1ms, 0ms, 1ms }) {
+                        const WallTime from = edge + offset;
+                        checkQuery(store, sessions, from, from + 1ms);
+                        checkQuery(store, sessions, from, from + 10s);
+                        checkQuery(store, sessions, from - 30s, from);
+                        checkQuery(store, sessions, from, sessions.back().end + 1h);
+                    }
+                }
+            }
+        }
+
+    } // namespace
+
+    LAF_TEST(SessionStore, queriesAtIndexBoundaries) {
+        for (const bool touching : { false, true }) {
+            const TempPath path("sessions");
+            SessionStore store;
+            LAF_REQUIRE(store.open(path.str()));
+            const auto sessions = makeSessions(2 * kStride + 3, touching);
+            LAF_REQUIRE(appendAll(store, sessions));
+
+            checkQueriesAround(store, sessions,
+                { 0, 1, kStride - 1, kStride, kStride + 1, 2 * kStride - 1, 2 * kStride, sessions.size() - 1 });
+            checkQuery(store, sessions, kBase - 1h, kBase);
+            checkQuery(store, sessions, kBase - 1h, sessions.back().end + 1h);
+            checkQuery(store, sessions, sessions.back().end, sessions.back().end + 1h);
+        }
+    }
+
+    LAF_TEST(SessionStore, queriesWithExactlyOneFullBlock) {
+        const TempPath path("sessions");
+        SessionStore store;
+        LAF_REQUIRE(store.open(path.str()));
+        const auto sessions = makeSessions(kStride, false);
+        LAF_REQUIRE(appendAll(store, sessions));
+
+        checkQueriesAround(store, sessions, { 0, kStride - 1 });
+        LAF_CHECK_EQ(store.getFocusTime(kBase, sessions.back().end), Timer::Duration(5s) * static_cast<std::int64_t>(kStride));
+    }
+
+    LAF_TEST(SessionStore, emptyStoreVisitsNothing) {
+        const TempPath path("sessions");
+        SessionStore store;
+        LAF_REQUIRE(store.open(path.str()));
+
+        checkQuery(store, {}, kBase - 1h, kBase + 1h);
+        LAF_CHECK_EQ(store.getFocusTime(kBase - 1h, kBase + 1h), Timer::Duration::zero());
+    }
+
+    LAF_TEST(SessionStore, reopenDropsTornTrailingRecord) {
+        const TempPath path("sessions");
+        const auto sessions = makeSessions(kStride + 1, false);
+        {
+            SessionStore store;
+            LAF_REQUIRE(store.open(path.str()));
+            LAF_REQUIRE(appendAll(store, sessions));
+        }
+        const auto intactSize = std::filesystem::file_size(path.str());
+
+        // A crash mid-append leaves part of the next record, which starts a new block
+        if (std::FILE* file = std::fopen(path.str().c_str(), "ab")) {
+            const unsigned char partial[7] = { 1, 2, 3, 4, 5, 6, 7 };
+            std::fwrite(partial, 1, sizeof(partial), file);
+            std::fclose(file);
+        }
+
+        SessionStore store;
+        LAF_REQUIRE(store.open(path.str()));
+        LAF_CHECK_EQ(store.getSessionCount(), sessions.size());
+        LAF_CHECK_EQ(std::filesystem::file_size(path.str()), intactSize);
+        checkQueriesAround(store, sessions, { 0, kStride - 1, kStride });
+
+        // Appending continues cleanly after the dropped bytes
+        auto extended = sessions;
+        const WallTime next = sessions.back().end + 5s;
+        extended.push_back({ next, next + 5s });
+        LAF_REQUIRE(store.append(extended.back().start, extended.back().end));
+        checkQueriesAround(store, extended, { kStride, kStride + 1 });
+    }
+
+    LAF_TEST(SessionStore, reopenRebuildsStaleIndex) {
+        const TempPath path("sessions");
+        const auto sessions = makeSessions(2 * kStride + 1, false);
+        {
+            SessionStore store;
+            LAF_REQUIRE(store.open(path.str()));
+            LAF_REQUIRE(appendAll(store, sessions));
+        }
+
+        // Index left behind by a crash before its last entry was written
+        std::filesystem::resize_file(path.str() + ".idx", 2 * 8);
+
+        SessionStore store;
+        LAF_REQUIRE(store.open(path.str()));
+        LAF_CHECK_EQ(std::filesystem::file_size(path.str() + ".idx"), std::uintmax_t{ 3 * 8 });
+        checkQueriesAround(store, sessions, { 2 * kStride - 1, 2 * kStride });
+    }
+
+} // namespace LockedAndFlow::Test
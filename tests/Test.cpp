@@ -0,0 +1,119 @@
+#include "Test.h"
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <exception>
+#include <filesystem>
+#include <string_view>
+#include <vector>
+
+namespace LockedAndFlow::Test {
+
+    namespace {
+
+        struct Registration {
+            std::string name;
+            TestFunction function;
+        };
+
+        std::vector<Registration>& registry() {
+            static std::vector<Registration> tests;
+            return tests;
+        }
+
+        std::size_t& currentFailures() {
+            static std::size_t failures = 0;
+            return failures;
+        }
+
+        std::string parseFilter(int argc, char** argv) {
+            std::string filter;
+            for (int i = 1; i < argc; ++i) {
+                const std::string_view arg(argv[i]);
+                if (arg.rfind("--filter=", 0) == 0) {
+                    filter = std::string(arg.substr(9));
+                }
+                else {
+                    std::fprintf(arg == "--help" ? stdout : stderr, "Usage: %s [--filter=<substring>]\n", argv[0]);
+                    std::exit(arg == "--help" ? 0 : 1);
+                }
+            }
+            return filter;
+        }
+
+    } // namespace
+
+    bool registerTest(std::string name, TestFunction function) {
+        registry().push_back(Registration{ std::move(name), std::move(function) });
+        return true;
+    }
+
+    void reportFailure(const char* file, int line, const std::string& message) {
+        ++currentFailures();
+        std::printf("  %s:%d: check failed: %s\n", file, line, message.c_str());
+    }
+
+    TempPath::TempPath(const std::string& name) {
+        // Several test processes may run at once under ctest -j
+        const auto file = "lockedandflow_test_" + std::to_string(std::chrono::steady_clock::now().time_since_epoch().count()) +
+            "_" + name;
+        path_ = (std::filesystem::temp_directory_path() / file).string();
+        removeFiles();
+    }
+
+    TempPath::~TempPath() {
+        removeFiles();
+    }
+
+    void TempPath::removeFiles() const {
+        const std::filesystem::path path(path_);
+        const std::string prefix = path.filename().string();
+        std::error_code error;
+        for (const auto& entry : std::filesystem::directory_iterator(path.parent_path(), error)) {
+            if (entry.path().filename().string().rfind(prefix, 0) == 0) {
+                std::filesystem::remove(entry.path(), error);
+            }
+        }
+    }
+
+    int runTests(int argc, char** argv) {
+        const std::string filter = parseFilter(argc, argv);
+
+        auto tests = registry();
+        std::sort(tests.begin(), tests.end(),
+            [](const Registration& a, const Registration& b) { return a.name < b.name; });
+
+        std::size_t run = 0;
+        std::size_t failed = 0;
+        for (const auto& test : tests) {
+            if (!filter.empty() && test.name.find(filter) == std::string::npos) {
+                continue;
+            }
+
+            ++run;
+            currentFailures() = 0;
+            try {
+                test.function();
+            }
+            catch (const std::exception& error) {
+                reportFailure(__FILE__, __LINE__, std::string("uncaught exception: ") + error.what());
+            }
+            if (currentFailures() > 0) {
+                ++failed;
+            }
+            std::printf("%-4s %s\n", currentFailures() > 0 ? "FAIL" : "ok", test.name.c_str());
+        }
+
+        std::printf("%zu tests, %zu failed\n", run, failed);
+        if (run == 0) {
+            std::fprintf(stderr, "No tests match '%s'\n", filter.c_str());
+            return 1;
+        }
+        return failed == 0 ? 0 : 1;
+    }
+
+} // namespace LockedAndFlow::Test
+
+int main(int argc, char** argv) {
+    return LockedAndFlow::Test::runTests(argc, argv);
+}
@@ -0,0 +1,111 @@
+#pragma once
+
+#include <chrono>
+#include <functional>
+#include <optional>
+#include <ostream>
+#include <sstream>
+#include <string>
+#include <type_traits>
+#include <utility>
+
+namespace LockedAndFlow::Test {
+
+    using TestFunction = std::function<void()>;
+
+    // Registers a test under a slash-separated name (e.g. "TimerPool/staleHandle")
+    bool registerTest(std::string name, TestFunction function);
+
+    // Runs every registered test matching the command line filter; non-zero if any failed
+    int runTests(int argc, char** argv);
+
+    // Records a failed check against the running test
+    void reportFailure(const char* file, int line, const std::string& message);
+
+    /**
+     * @brief Unique path in the temp directory for a test's files
+     *
+     * Removes the path, and any file named with it as a prefix (e.g. an
+     * index beside a data file), on construction and destruction.
+     */
+    class TempPath {
+    public:
+        explicit TempPath(const std::string& name);
+        ~TempPath();
+
+        TempPath(const TempPath&) = delete;
+        TempPath& operator=(const TempPath&) = delete;
+
+        const std::string& str() const noexcept { return path_; }
+
+    private:
+        std::string path_;
+
+        void removeFiles() const;
+    };
+
+    namespace Detail {
+
+        template <typename T, typename = void>
+        struct IsStreamable : std::false_type {};
+        template <typename T>
+        struct IsStreamable<T, std::void_t<decltype(std::declval<std::ostream&>() << std::declval<const T&>())>>
+            : std::true_type {};
+
+        template <typename T>
+        std::string describe(const T& value) {
+            std::ostringstream out;
+            if constexpr (std::is_enum_v<T>) {
+                out << static_cast<long long>(value);
+            }
+            else if constexpr (IsStreamable<T>::value) {
+                out << value;
+            }
+            else {
+                out << "<unprintable>";
+            }
+            return out.str();
+        }
+
+        template <typename Rep, typename Period>
+        std::string describe(const std::chrono::duration<Rep, Period>& value) {
+            return describe(value.count()) + " ticks";
+        }
+
+        template <typename T>
+        std::string describe(const std::optional<T>& value) {
+            return value ? describe(*value) : std::string("nullopt");
+        }
+
+        template <typename A, typename B>
+        bool checkEqual(const A& actual, const B& expected, const char* actualText, const char* expectedText,
+            const char* file, int line) {
+            if (actual == expected) {
+                return true;
+            }
+            reportFailure(file, line, std::string(actualText) + " == " + expectedText + "\n    actual:   " +
+                describe(actual) + "\n    expected: " + describe(expected));
+            return false;
+        }
+
+    } // namespace Detail
+
+} // namespace LockedAndFlow::Test
+
+#define LAF_TEST_CONCAT_IMPL(a, b) a##b
+#define LAF_TEST_CONCAT(a, b) LAF_TEST_CONCAT_IMPL(a, b)
+
+// Defines and registers a test body: LAF_TEST(TimerPool, staleHandle) { ... }
+#define LAF_TEST(suite, name) \
+    static void LAF_TEST_CONCAT(suite##_##name, _test)(); \
+    static const bool LAF_TEST_CONCAT(suite##_##name, _registered) = \
+        ::LockedAndFlow::Test::registerTest(#suite "/" #name, LAF_TEST_CONCAT(suite##_##name, _test)); \
+    static void LAF_TEST_CONCAT(suite##_##name, _test)()
+
+// Failed checks are reported and the test continues; LAF_REQUIRE also returns
+#define LAF_CHECK(condition) \
+    ((condition) ? true : (::LockedAndFlow::Test::reportFailure(__FILE__, __LINE__, #condition), false))
+#define LAF_CHECK_EQ(actual, expected) \
+    ::LockedAndFlow::Test::Detail::checkEqual((actual), (expected), #actual, #expected, __FILE__, __LINE__)
+#define LAF_REQUIRE(condition) \
+    do { if (!LAF_CHECK(condition)) { return; } } while (false)
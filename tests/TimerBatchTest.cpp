@@ -0,0 +1,169 @@
+#include "Test.h"
+#include "TimerBatch.h"
+#include <cstdint>
+#include <cstring>
+#include <random>
+#include <string>
+#include <vector>
+
+namespace LockedAndFlow::Test {
+
+    namespace {
+
+        using Duration = Timer::Duration;
+        using TimePoint = Timer::TimePoint;
+        using Ticks = TimePoint::duration;
+
+        const TimePoint kNow = TimePoint() + std::chrono::hours(24 * 365);
+
+        // Timers as arrays, in the layout TimerPool hands to evaluateTimerBatch()
+        struct Batch {
+            std::vector<TimerState> states;
+            std::vector<TimePoint> startTimes;
+            std::vector<Duration> totalElapsed;
+            std::vector<Duration> targets;
+            std::vector<std::uint8_t> hasTarget;
+
+            void add(TimerState state, Ticks sinceStart, Duration total, std::optional<Duration> target) {
+                states.push_back(state);
+                startTimes.push_back(kNow - sinceStart);
+                totalElapsed.push_back(total);
+                targets.push_back(target.value_or(Duration::zero()));
+                hasTarget.push_back(target ? 1 : 0);
+            }
+
+            TimerBatchInput input(std::size_t count) const {
+                return { states.data(), startTimes.data(), totalElapsed.data(), targets.data(), hasTarget.data(), count };
+            }
+        };
+
+        struct Results {
+            std::vector<Duration> elapsed;
+            std::vector<Duration> remaining;
+            std::vector<float> progress;
+
+            explicit Results(std::size_t count)
+                : elapsed(count, Duration(-1)), remaining(count, Duration(-1)), progress(count, -1.0f) {
+            }
+
+            TimerBatchOutput output() {
+                return { elapsed.data(), remaining.data(), progress.data() };
+            }
+        };
+
+        bool sameBits(float a, float b) {
+            return std::memcmp(&a, &b, sizeof(float)) == 0;
+        }
+
+        // Runs @p path over every prefix of @p batch and compares with the scalar kernel
+        void checkMatchesScalar(const Batch& batch, TimerBatchPath path) {
+            for (std::size_t count = 0; count <= batch.states.size(); ++count) {
+                Results scalar(count);
+                Results vector(count);
+                evaluateTimerBatch(batch.input(count), kNow, scalar.output(), TimerBatchPath::Scalar);
+                evaluateTimerBatch(batch.input(count), kNow, vector.output(), path);
+
+                for (std::size_t i = 0; i < count; ++i) {
+                    const bool same = vector.elapsed[i] == scalar.elapsed[i] &&
+                        vector.remaining[i] == scalar.remaining[i] &&
+                        sameBits(vector.progress[i], scalar.progress[i]);
+                    if (!same) {
+                        reportFailure(__FILE__, __LINE__, std::string(toString(path)) + " differs from scalar at " +
+                            std::to_string(i) + " of " + std::to_string(count) + ": elapsed " +
+                            std::to_string(vector.elapsed[i].count()) + " vs " + std::to_string(scalar.elapsed[i].count()) +
+                            ", remaining " + std::to_string(vector.remaining[i].count()) + " vs " +
+                            std::to_string(scalar.remaining[i].count()) + ", progress " +
+                            std::to_string(vector.progress[i]) + " vs " + std::to_string(scalar.progress[i]));
+                        return;
+                    }
+                }
+            }
+        }
+
+        void checkAllPaths(const Batch& batch) {
+            checkMatchesScalar(batch, TimerBatchPath::Sse2);
+            checkMatchesScalar(batch, TimerBatchPath::Avx2); // Degrades to the best path without AVX2
+            checkMatchesScalar(batch, TimerBatchPath::Auto);
+        }
+
+        // Boundary cases, in an order that puts each one in every lane position over the prefixes
+        Batch edgeCases() {
+            using namespace std::chrono_literals;
+            Batch batch;
+            for (const TimerState state : { TimerState::Running, TimerState::Paused, TimerState::Stopped }) {
+                batch.add(state, 1500ms, 0ms, 1000ms);          // Past the target
+                batch.add(state, 1000ms, 0ms, 1000ms);          // Exactly at it
+                batch.add(state, 999999us, 0ms, 1000ms);        // One tick short of the next millisecond
+                batch.add(state, 500ms, 500ms, 1000ms);         // At it through the total
+                batch.add(state, 5s, 10s, 0ms);                 // Zero target
+                batch.add(state, 3s, 0ms, std::nullopt);        // No target
+                batch.add(state, -2500us, 0ms, 1000ms);         // Started after now: negative run
+                batch.add(state, -1500us, 0ms, 1000ms);         // Rounds away from truncation
+                batch.add(state, -999999ns, 0ms, 1000ms);
+                batch.add(state, -1ns, 0ms, 1000ms);
+                batch.add(state, 2s, -5s, 1000ms);              // Negative total
+                batch.add(state, -7s, -3s, std::nullopt);
+                batch.add(state, 1ms, 0ms, 1ms);
+                batch.add(state, 0ns, 0ms, 1ms);
+            }
+            return batch;
+        }
+
+    } // namespace
+
+    LAF_TEST(TimerBatch, vectorPathsMatchScalarOnEdgeCases) {
+        checkAllPaths(edgeCases());
+    }
+
+    LAF_TEST(TimerBatch, vectorPathsMatchScalarBeyondExactDoubleRange) {
+        // Blocks holding values past 2^51 ticks take the scalar fallback; mixed with normal lanes
+        using namespace std::chrono_literals;
+        Batch batch;
+        batch.add(TimerState::Running, 10s, 0ms, 20s);
+        batch.add(TimerState::Running, Ticks(std::int64_t{ 1 } << 52), 0ms, 1000ms);
+        batch.add(TimerState::Paused, 0ns, Duration(std::int64_t{ 1 } << 53), Duration(std::int64_t{ 1 } << 53));
+        batch.add(TimerState::Running, -Ticks(std::int64_t{ 1 } << 52), 0ms, 1000ms);
+        batch.add(TimerState::Stopped, 0ns, 1ms, Duration(-(std::int64_t{ 1 } << 52)));
+        batch.add(TimerState::Running, 3s, 0ms, std::nullopt);
+        checkAllPaths(batch);
+    }
+
+    LAF_TEST(TimerBatch, vectorPathsMatchScalarOnRandomTimers) {
+        std::mt19937_64 random(42);
+        const auto pick = [&random](std::int64_t low, std::int64_t high) {
+            return low + static_cast<std::int64_t>(random() % static_cast<std::uint64_t>(high - low + 1));
+        };
+
+        Batch batch;
+        for (int i = 0; i < 1021; ++i) { // Not a multiple of any vector width
+            const auto state = static_cast<TimerState>(pick(0, 2));
+            const Ticks sinceStart(pick(-3'600'000'000'000, 36'000'000'000'000));
+            const Duration total(pick(-1000, 10'000'000));
+            const bool hasTarget = pick(0, 3) != 0;
+            const Duration target(pick(0, 1) ? pick(0, 10'000'000) : total.count() + pick(-2, 2));
+            batch.add(state, sinceStart, total, hasTarget ? std::optional<Duration>(target) : std::nullopt);
+        }
+        checkAllPaths(batch);
+    }
+
+    LAF_TEST(TimerBatch, scalarMatchesTimer) {
+        // The reference the vector paths are held to is Timer's own arithmetic
+        const Batch batch = edgeCases();
+        Results results(batch.states.size());
+        evaluateTimerBatch(batch.input(batch.states.size()), kNow, results.output(), TimerBatchPath::Scalar);
+
+        for (std::size_t i = 0; i < batch.states.size(); ++i) {
+            Timer::Snapshot snapshot;
+            snapshot.state = batch.states[i];
+            snapshot.startTime = batch.startTimes[i];
+            snapshot.totalElapsed = batch.totalElapsed[i];
+            snapshot.hasTarget = batch.hasTarget[i] != 0;
+            snapshot.target = batch.targets[i];
+
+            LAF_CHECK_EQ(results.elapsed[i], snapshot.getElapsed(kNow));
+            LAF_CHECK_EQ(results.remaining[i], snapshot.getRemainingTime(kNow).value_or(Duration::zero()));
+            LAF_CHECK(sameBits(results.progress[i], snapshot.getProgressPercent(kNow)));
+        }
+    }
+
+} // namespace LockedAndFlow::Test
@@ -0,0 +1,142 @@
+#include "Test.h"
+#include "TimerPool.h"
+#include <vector>
+
+namespace LockedAndFlow::Test {
+
+    namespace {
+
+        using namespace std::chrono_literals;
+
+        const TimerPool::TimePoint kStart = TimerPool::TimePoint() + 1h;
+
+    } // namespace
+
+    LAF_TEST(TimerPool, recycledSlotGetsNewGeneration) {
+        TimerPool pool;
+        const auto first = pool.create();
+        pool.destroy(first);
+        const auto second = pool.create();
+
+        LAF_CHECK_EQ(second.index, first.index);
+        LAF_CHECK(second.generation != first.generation);
+        LAF_CHECK(!pool.isValid(first));
+        LAF_CHECK(pool.isValid(second));
+        LAF_CHECK_EQ(pool.size(), std::size_t{ 1 });
+    }
+
+    LAF_TEST(TimerPool, staleHandleCannotTouchNewOwner) {
+        TimerPool pool;
+        const auto stale = pool.create();
+        pool.destroy(stale);
+        const auto owner = pool.create();
+        pool.setTargetDuration(owner, 10s);
+
+        pool.start(stale, kStart);
+        pool.setTargetDuration(stale, 1s);
+        LAF_CHECK_EQ(pool.getState(owner), TimerState::Stopped);
+        LAF_CHECK_EQ(pool.getTargetDuration(owner), std::optional<TimerPool::Duration>(10s));
+
+        pool.start(owner, kStart);
+        pool.pause(stale, kStart + 2s);
+        pool.stop(stale, kStart + 2s);
+        pool.reset(stale);
+        pool.clearTargetDuration(stale);
+        LAF_CHECK_EQ(pool.getState(owner), TimerState::Running);
+        LAF_CHECK_EQ(pool.getElapsed(owner, kStart + 3s), TimerPool::Duration(3s));
+        LAF_CHECK_EQ(pool.getTargetDuration(owner), std::optional<TimerPool::Duration>(10s));
+    }
+
+    LAF_TEST(TimerPool, staleHandleQueriesReturnDefaults) {
+        TimerPool pool;
+        const auto stale = pool.create();
+        pool.setTargetDuration(stale, 5s);
+        pool.start(stale, kStart);
+        pool.destroy(stale);
+        const auto owner = pool.create();
+        pool.setTargetDuration(owner, 10s);
+        pool.start(owner, kStart);
+
+        LAF_CHECK_EQ(pool.getState(stale), TimerState::Stopped);
+        LAF_CHECK_EQ(pool.getElapsed(stale, kStart + 1s), TimerPool::Duration::zero());
+        LAF_CHECK(!pool.getTargetDuration(stale));
+        LAF_CHECK(!pool.getRemainingTime(stale, kStart + 1s));
+        LAF_CHECK_EQ(pool.getProgressPercent(stale, kStart + 1s), 0.0f);
+    }
+
+    LAF_TEST(TimerPool, destroyWithStaleHandleKeepsNewOwner) {
+        TimerPool pool;
+        const auto stale = pool.create();
+        pool.destroy(stale);
+        const auto owner = pool.create();
+
+        pool.destroy(stale); // Must not free the slot a second time
+        LAF_CHECK(pool.isValid(owner));
+        LAF_CHECK_EQ(pool.size(), std::size_t{ 1 });
+
+        const auto other = pool.create();
+        LAF_CHECK(other.index != owner.index);
+        LAF_CHECK_EQ(pool.size(), std::size_t{ 2 });
+    }
+
+    LAF_TEST(TimerPool, destroyCancelsScheduledExpiry) {
+        TimerPool pool;
+        const auto destroyed = pool.create();
+        pool.setTargetDuration(destroyed, 1s);
+        pool.start(destroyed, kStart);
+        pool.destroy(destroyed);
+
+        // The recycled slot runs without a target: the old deadline must not stop it
+        const auto owner = pool.create();
+        pool.start(owner, kStart);
+        std::vector<TimerPool::Handle> expired;
+        LAF_CHECK_EQ(pool.updateAll(kStart + 2s, &expired), std::size_t{ 0 });
+        LAF_CHECK(expired.empty());
+        LAF_CHECK_EQ(pool.getState(owner), TimerState::Running);
+        LAF_CHECK(!pool.nextDeadline());
+    }
+
+    LAF_TEST(TimerPool, outOfRangeHandleIsInvalid) {
+        TimerPool pool;
+        pool.create();
+        const TimerPool::Handle bogus{ 7, 0 };
+        LAF_CHECK(!pool.isValid(bogus));
+        pool.start(bogus, kStart);
+        pool.destroy(bogus);
+        LAF_CHECK_EQ(pool.size(), std::size_t{ 1 });
+        LAF_CHECK_EQ(pool.slotCount(), std::size_t{ 1 });
+    }
+
+    LAF_TEST(TimerPool, expiredHandlesCarryCurrentGeneration) {
+        TimerPool pool;
+        const auto stale = pool.create();
+        pool.destroy(stale);
+        const auto owner = pool.create();
+        pool.setTargetDuration(owner, 1s);
+        pool.start(owner, kStart);
+
+        std::vector<TimerPool::Handle> expired;
+        LAF_CHECK_EQ(pool.updateAll(kStart + 1s, &expired), std::size_t{ 1 });
+        LAF_REQUIRE(expired.size() == 1);
+        LAF_CHECK(expired[0] == owner);
+        LAF_CHECK(expired[0] != stale);
+    }
+
+    LAF_TEST(TimerPool, updateAllReturnsHandlesInExpiryOrder) {
+        TimerPool pool;
+        const auto slow = pool.create();
+        const auto fast = pool.create();
+        const auto middle = pool.create();
+        pool.setTargetDuration(slow, 50ms);
+        pool.setTargetDuration(fast, 5ms);
+        pool.setTargetDuration(middle, 5s);
+        pool.start(slow, kStart);
+        pool.start(fast, kStart);
+        pool.start(middle, kStart - 4990ms);
+
+        std::vector<TimerPool::Handle> expired;
+        LAF_CHECK_EQ(pool.updateAll(kStart + 1s, &expired), std::size_t{ 3 });
+        LAF_CHECK(expired == (std::vector<TimerPool::Handle>{ fast, middle, slow }));
+    }
+
+} // namespace LockedAndFlow::Test
@@ -0,0 +1,162 @@
+#include "Test.h"
+#include "Seqlock.h"
+#include "Timer.h"
+#include <vector>
+
+namespace LockedAndFlow::Test {
+
+    namespace {
+
+        using namespace std::chrono_literals;
+
+        const Timer::TimePoint kStart = Timer::TimePoint() + 1h;
+
+        // Seqlock bumps its sequence twice per write
+        std::uint64_t writesTo(const Timer::Publisher& publisher, std::uint64_t sequenceBefore) {
+            return (publisher.getSequence() - sequenceBefore) / 2;
+        }
+
+        // Elapsed time of every Tick notification, in milliseconds
+        struct TickRecorder {
+            std::vector<std::int64_t> ticks;
+
+            explicit TickRecorder(Timer& timer) {
+                timer.subscribe([this](const TimerNotification& notification) {
+                    ticks.push_back(notification.elapsed.count());
+                }, TimerEvent::Tick);
+            }
+
+            // Ticks since the last call
+            std::vector<std::int64_t> take() {
+                std::vector<std::int64_t> taken;
+                taken.swap(ticks);
+                return taken;
+            }
+        };
+
+        using Ticks = std::vector<std::int64_t>;
+
+    } // namespace
+
+    LAF_TEST(Timer, publisherSnapshotMatchesTimer) {
+        Timer timer;
+        Timer::Publisher publisher;
+        timer.setPublisher(&publisher);
+        timer.setTargetDuration(25min);
+        timer.saveElapsed(3s);
+        timer.start(kStart);
+
+        const auto snapshot = publisher.read();
+        LAF_CHECK_EQ(snapshot.state, TimerState::Running);
+        LAF_CHECK(snapshot.hasTarget);
+        LAF_CHECK_EQ(snapshot.target, Timer::Duration(25min));
+        LAF_CHECK(snapshot.startTime == kStart);
+        LAF_CHECK_EQ(snapshot.getElapsed(kStart + 2s), timer.getElapsed(kStart + 2s));
+        LAF_CHECK_EQ(snapshot.getRemainingTime(kStart + 2s), timer.getRemainingTime(kStart + 2s));
+    }
+
+    LAF_TEST(Timer, resetPublishesOnce) {
+        Timer timer;
+        Timer::Publisher publisher;
+        timer.setPublisher(&publisher);
+
+        // Running -> Stopped: setState() publishes the change
+        timer.start(kStart);
+        std::uint64_t before = publisher.getSequence();
+        timer.reset();
+        LAF_CHECK_EQ(writesTo(publisher, before), std::uint64_t{ 1 });
+        LAF_CHECK_EQ(publisher.read().state, TimerState::Stopped);
+
+        // Already stopped: only the cleared elapsed time changes, and is still published
+        timer.start(kStart);
+        timer.stop(kStart + 5s);
+        LAF_CHECK_EQ(publisher.read().totalElapsed, Timer::Duration(5s));
+        before = publisher.getSequence();
+        timer.reset();
+        LAF_CHECK_EQ(writesTo(publisher, before), std::uint64_t{ 1 });
+        LAF_CHECK_EQ(publisher.read().totalElapsed, Timer::Duration::zero());
+    }
+
+    LAF_TEST(Timer, seqlockRoundTripsPaddedValue) {
+        struct Padded {
+            std::uint8_t flag = 1;
+            std::uint64_t value = 2;
+            std::uint16_t tail = 3;
+        };
+
+        Seqlock<Padded> lock;
+        LAF_CHECK_EQ(lock.read().value, std::uint64_t{ 2 });
+        lock.write(Padded{ 7, 0x0123456789abcdefULL, 9 });
+        Padded read;
+        LAF_REQUIRE(lock.tryRead(read));
+        LAF_CHECK_EQ(read.flag, std::uint8_t{ 7 });
+        LAF_CHECK_EQ(read.value, std::uint64_t{ 0x0123456789abcdefULL });
+        LAF_CHECK_EQ(read.tail, std::uint16_t{ 9 });
+        LAF_CHECK_EQ(lock.getSequence(), std::uint64_t{ 2 });
+    }
+
+    LAF_TEST(Timer, startDoesNotTickSecondZero) {
+        Timer timer;
+        TickRecorder recorder(timer);
+        timer.start(kStart);
+
+        timer.update(kStart);
+        timer.update(kStart + 999ms);
+        LAF_CHECK(recorder.take().empty());
+        timer.update(kStart + 1s);
+        LAF_CHECK(recorder.take() == Ticks{ 1000 });
+        timer.update(kStart + 1500ms);
+        LAF_CHECK(recorder.take().empty());
+
+        // Skipped frames tick once, at the latest second
+        timer.update(kStart + 4200ms);
+        LAF_CHECK(recorder.take() == Ticks{ 4200 });
+    }
+
+    LAF_TEST(Timer, resumeTicksAtNextNewSecond) {
+        Timer timer;
+        TickRecorder recorder(timer);
+        timer.start(kStart);
+        timer.update(kStart + 3500ms);
+        LAF_CHECK(recorder.take() == Ticks{ 3500 });
+        timer.pause(kStart + 3500ms);
+
+        const auto resumed = kStart + 1min;
+        timer.start(resumed);
+        timer.update(resumed);
+        timer.update(resumed + 499ms);
+        LAF_CHECK(recorder.take().empty());
+        timer.update(resumed + 500ms);
+        LAF_CHECK(recorder.take() == Ticks{ 4000 });
+    }
+
+    LAF_TEST(Timer, resetStartsTicksOver) {
+        Timer timer;
+        TickRecorder recorder(timer);
+        timer.start(kStart);
+        timer.update(kStart + 5200ms);
+        LAF_CHECK(recorder.take() == Ticks{ 5200 });
+        timer.reset();
+
+        // Without the reset, second 0 would differ from the last tick (5) and fire
+        const auto restarted = kStart + 1min;
+        timer.start(restarted);
+        timer.update(restarted);
+        LAF_CHECK(recorder.take().empty());
+        timer.update(restarted + 1s);
+        LAF_CHECK(recorder.take() == Ticks{ 1000 });
+    }
+
+    LAF_TEST(Timer, restoredElapsedDoesNotTick) {
+        Timer timer;
+        TickRecorder recorder(timer);
+        timer.saveElapsed(7500ms);
+        timer.start(kStart);
+
+        timer.update(kStart);
+        LAF_CHECK(recorder.take().empty());
+        timer.update(kStart + 500ms);
+        LAF_CHECK(recorder.take() == Ticks{ 8000 });
+    }
+
+} // namespace LockedAndFlow::Test
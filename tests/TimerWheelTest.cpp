@@ -0,0 +1,216 @@
+#include "Test.h"
+#include "TimerWheel.h"
+#include <algorithm>
+#include <map>
+#include <random>
+#include <vector>
+
+namespace LockedAndFlow::Test {
+
+    namespace {
+
+        using namespace std::chrono_literals;
+        using Key = TimerWheel::Key;
+        using TimePoint = TimerWheel::TimePoint;
+        using Offset = TimePoint::duration;
+
+        // Level spans: 64 ms, 4096 ms, 2^18 ms, ... ; the top level ends at 2^36 ms
+        constexpr std::int64_t kLevelSpan[] = { 64, 4096, 262144, 16777216, 1073741824, 68719476736 };
+
+        // Whole milliseconds since the clock's epoch, aligned so that every level's digit is zero
+        const TimePoint kAligned = TimePoint() + std::chrono::milliseconds(std::int64_t(1) << 40);
+
+        std::vector<Key> advanceTo(TimerWheel& wheel, TimePoint now) {
+            std::vector<Key> expired;
+            wheel.advance(now, expired);
+            std::sort(expired.begin(), expired.end());
+            return expired;
+        }
+
+        // Schedules every deadline, then for each one checks that nothing fires a
+        // nanosecond early and that exactly its key fires at the deadline
+        void checkFiresExactly(TimePoint start, const std::vector<Offset>& offsets) {
+            TimerWheel wheel;
+            std::vector<Key> none;
+            wheel.advance(start, none);
+            LAF_REQUIRE(none.empty());
+
+            std::vector<TimePoint> deadlines;
+            for (Key key = 0; key < offsets.size(); ++key) {
+                deadlines.push_back(start + offsets[key]);
+                wheel.schedule(key, deadlines.back());
+            }
+
+            std::vector<Key> order(offsets.size());
+            for (Key key = 0; key < order.size(); ++key) {
+                order[key] = key;
+            }
+            std::sort(order.begin(), order.end(), [&](Key a, Key b) { return deadlines[a] < deadlines[b]; });
+
+            for (const Key key : order) {
+                LAF_CHECK(wheel.nextDeadline() == std::optional<TimePoint>(deadlines[key]));
+                if (!LAF_CHECK(advanceTo(wheel, deadlines[key] - 1ns).empty())) {
+                    std::printf("    key %u fired early (offset %lld ms)\n", key,
+                        static_cast<long long>(std::chrono::duration_cast<std::chrono::milliseconds>(offsets[key]).count()));
+                }
+                if (!LAF_CHECK(advanceTo(wheel, deadlines[key]) == std::vector<Key>{ key })) {
+                    std::printf("    key %u did not fire alone at its deadline (offset %lld ms)\n", key,
+                        static_cast<long long>(std::chrono::duration_cast<std::chrono::milliseconds>(offsets[key]).count()));
+                }
+            }
+            LAF_CHECK(wheel.empty());
+            LAF_CHECK(!wheel.nextDeadline());
+        }
+
+        // Deadlines one before, at and one after each level boundary
+        std::vector<Offset> boundaryOffsets() {
+            std::vector<Offset> offsets;
+            for (const std::int64_t span : kLevelSpan) {
+                for (const std::int64_t delta : { -1, 0, 1 }) {
+                    offsets.push_back(std::chrono::milliseconds(span + delta));
+                }
+            }
+            offsets.push_back(std::chrono::milliseconds(kLevelSpan[5] * 3 + 7));   // Overflow list
+            return offsets;
+        }
+
+    } // namespace
+
+    LAF_TEST(TimerWheel, firesAtLevelBoundariesFromAlignedTick) {
+        checkFiresExactly(kAligned, boundaryOffsets());
+    }
+
+    LAF_TEST(TimerWheel, firesAtLevelBoundariesFromUnalignedTick) {
+        // Every digit at its maximum, so the first millisecond carries through all levels
+        checkFiresExactly(kAligned + TimerWheel::Duration(kLevelSpan[5] - 1), boundaryOffsets());
+        checkFiresExactly(kAligned + 37ms, boundaryOffsets());
+        checkFiresExactly(kAligned + 4095ms + 500us, boundaryOffsets());
+    }
+
+    LAF_TEST(TimerWheel, cascadesBeyond64And4096Milliseconds) {
+        // Several entries per slot on the way down, including sub-millisecond deadlines
+        std::vector<Offset> offsets;
+        for (const std::int64_t ms : { 65, 100, 127, 128, 4097, 4100, 5000, 8191, 8192, 300000 }) {
+            offsets.push_back(std::chrono::milliseconds(ms));
+            offsets.push_back(std::chrono::milliseconds(ms) + 500us);
+        }
+        checkFiresExactly(kAligned + 10ms, offsets);
+
+        TimerWheel wheel;
+        std::vector<Key> none;
+        wheel.advance(kAligned, none);
+        wheel.schedule(0, kAligned + 5000ms + 250us);
+        wheel.schedule(1, kAligned + 5000ms + 750us);
+        LAF_CHECK(advanceTo(wheel, kAligned + 5000ms + 500us) == std::vector<Key>{ 0 });
+        LAF_CHECK(wheel.nextDeadline() == std::optional<TimePoint>(kAligned + 5000ms + 750us));
+        LAF_CHECK(advanceTo(wheel, kAligned + 5001ms) == std::vector<Key>{ 1 });
+    }
+
+    LAF_TEST(TimerWheel, expiredKeysComeOutInDeadlineOrder) {
+        TimerWheel wheel;
+        std::vector<Key> expired;
+        wheel.advance(kAligned, expired);
+
+        // Scheduled newest-first, across level 0, level 1 and level 2 slots, with
+        // two deadlines inside one millisecond and one already in the past
+        wheel.schedule(1, kAligned + 300000ms);
+        wheel.schedule(2, kAligned + 200ms + 700us);
+        wheel.schedule(3, kAligned + 200ms + 300us);
+        wheel.schedule(4, kAligned + 10ms);
+        wheel.schedule(5, kAligned + 5ms);
+        wheel.schedule(6, kAligned - 1ms);
+        wheel.schedule(7, kAligned + 5000ms);
+        wheel.advance(kAligned + 400s, expired);
+        LAF_CHECK(expired == (std::vector<Key>{ 6, 5, 4, 3, 2, 7, 1 }));
+
+        // Spread over two calls: what is left of the due list comes first
+        expired.clear();
+        wheel.schedule(8, kAligned + 400s + 20ms);
+        wheel.schedule(9, kAligned + 400s + 10ms + 600us);
+        wheel.schedule(10, kAligned + 400s + 10ms + 200us);
+        wheel.advance(kAligned + 400s + 10ms + 400us, expired);
+        LAF_CHECK(expired == std::vector<Key>{ 10 });
+        wheel.advance(kAligned + 401s, expired);
+        LAF_CHECK(expired == (std::vector<Key>{ 10, 9, 8 }));
+    }
+
+    LAF_TEST(TimerWheel, rescheduleAndCancelDuringCascade) {
+        TimerWheel wheel;
+        std::vector<Key> none;
+        wheel.advance(kAligned, none);
+        wheel.schedule(0, kAligned + 5000ms);
+        wheel.schedule(1, kAligned + 5000ms);
+        wheel.schedule(2, kAligned + 300s);
+
+        // Partway: key 0 has cascaded to a lower level, then moves back up
+        LAF_CHECK(advanceTo(wheel, kAligned + 4100ms).empty());
+        wheel.schedule(0, kAligned + 400s);
+        wheel.cancel(2);
+        LAF_CHECK_EQ(wheel.size(), std::size_t{ 2 });
+        LAF_CHECK(advanceTo(wheel, kAligned + 5000ms) == std::vector<Key>{ 1 });
+        LAF_CHECK(advanceTo(wheel, kAligned + 399999ms).empty());
+        LAF_CHECK(advanceTo(wheel, kAligned + 400s) == std::vector<Key>{ 0 });
+        LAF_CHECK(wheel.empty());
+    }
+
+    LAF_TEST(TimerWheel, randomDeadlinesMatchReference) {
+        std::mt19937_64 random(18);
+        std::uniform_int_distribution<int> exponent(0, 37);
+        std::uniform_int_distribution<std::int64_t> nanos(0, 999999);
+        const auto randomSpan = [&]() {
+            const std::int64_t limit = std::int64_t(1) << exponent(random);
+            return std::chrono::milliseconds(std::uniform_int_distribution<std::int64_t>(0, limit)(random)) +
+                std::chrono::nanoseconds(nanos(random));
+        };
+
+        TimerWheel wheel;
+        std::map<Key, TimePoint> reference;
+        TimePoint now = kAligned + 12345ms;
+        std::vector<Key> none;
+        wheel.advance(now, none);
+
+        for (int round = 0; round < 2000; ++round) {
+            // A few schedules (some replacing live keys) and cancels, then a jump of random size
+            for (int i = 0; i < 4; ++i) {
+                const Key key = static_cast<Key>(random() % 256);
+                if (random() % 5 == 0) {
+                    wheel.cancel(key);
+                    reference.erase(key);
+                }
+                else {
+                    const TimePoint deadline = now + randomSpan();
+                    wheel.schedule(key, deadline);
+                    reference[key] = deadline;
+                }
+            }
+            LAF_REQUIRE(wheel.size() == reference.size());
+
+            std::optional<TimePoint> earliest;
+            for (const auto& [key, deadline] : reference) {
+                if (!earliest || deadline < *earliest) {
+                    earliest = deadline;
+                }
+            }
+            LAF_REQUIRE(wheel.nextDeadline() == earliest);
+
+            const auto jump = randomSpan() / static_cast<std::int64_t>(1 + random() % 64);
+            now += round % 3 == 0 && earliest ? Offset(*earliest - now) : Offset(jump);
+            std::vector<Key> expected;
+            for (auto it = reference.begin(); it != reference.end();) {
+                if (it->second <= now) {
+                    expected.push_back(it->first);
+                    it = reference.erase(it);
+                }
+                else {
+                    ++it;
+                }
+            }
+            const auto expired = advanceTo(wheel, now);
+            if (!LAF_CHECK(expired == expected)) {
+                std::printf("    round %d: %zu expired, %zu expected\n", round, expired.size(), expected.size());
+                return;
+            }
+        }
+    }
+
+} // namespace LockedAndFlow::Test